@@ -91,6 +91,11 @@ namespace TrenchBroom {
     static Func4<void, GLenum, GLsizei, GLenum, const GLvoid*>& _glDrawElements = glDrawElements;
     static Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*>& _glDrawRangeElements = glDrawRangeElements;
     static Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei>& _glMultiDrawElements = glMultiDrawElements;
+    
+    static Func2<void, GLsizei, GLuint*>& _glGenQueries = glGenQueries;
+    static Func2<void, GLsizei, const GLuint*>& _glDeleteQueries = glDeleteQueries;
+    static Func2<void, GLuint, GLenum>& _glQueryCounter = glQueryCounter;
+    static Func3<void, GLuint, GLenum, GLuint64*>& _glGetQueryObjectui64v = glGetQueryObjectui64v;
 
     static Func1<GLuint, GLenum>& _glCreateShader = glCreateShader;
     static Func1<void, GLuint>& _glDeleteShader = glDeleteShader;
@@ -221,6 +226,12 @@ namespace TrenchBroom {
         _glDrawRangeElements.bindFunc(glDrawRangeElements);
         _glMultiDrawElements.bindFunc(glMultiDrawElements);
         
+        // timer queries are optional, callers must check for GL_ARB_timer_query before using them
+        _glGenQueries.bindFunc(glGenQueries);
+        _glDeleteQueries.bindFunc(glDeleteQueries);
+        _glQueryCounter.bindFunc(glQueryCounter);
+        _glGetQueryObjectui64v.bindFunc(glGetQueryObjectui64v);
+        
         _glCreateShader.bindFunc(glCreateShader);
         _glDeleteShader.bindFunc(glDeleteShader);
         _glShaderSource.bindFunc(glShaderSource);
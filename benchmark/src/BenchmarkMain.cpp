@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+#include "MapGenerator.h"
+#include "TrenchBroomApp.h"
+
+#include <wx/config.h>
+#include <wx/fileconf.h>
+
+#include <algorithm>
+#include <clocale>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace TrenchBroom;
+
+static void printUsage() {
+    std::cerr << "Usage: TrenchBroom-Benchmark [options]" << std::endl
+              << "  --brushes <n,...>     brush counts of the generated maps (default: 1000,10000)" << std::endl
+              << "  --map <path>          benchmark the given map file, may be repeated" << std::endl
+              << "  --map-format <name>   format of the given map files (default: Standard)" << std::endl
+              << "  --runs <n>            number of runs per benchmark (default: 3)" << std::endl
+              << "  --filter <text>       only run benchmarks whose name contains the given text" << std::endl
+              << "  --format <json|csv>   format of the results (default: json)" << std::endl
+              << "  --output <path>       write the results to the given file instead of stdout" << std::endl;
+}
+
+static bool readFile(const String& path, String& contents) {
+    std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+    if (!stream.is_open())
+        return false;
+
+    std::stringstream str;
+    str << stream.rdbuf();
+    contents = str.str();
+    return true;
+}
+
+static int runBenchmarks(int argc, char** argv) {
+    StringList brushCounts = StringUtils::split("1000,10000", ',');
+    StringList mapPaths;
+    String mapFormatName = "Standard";
+    size_t runCount = 3;
+    String filter;
+    String format = "json";
+    String outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const String option = argv[i];
+        if (option == "--help") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+
+        const String value = argv[++i];
+        if (option == "--brushes") {
+            brushCounts = StringUtils::split(value, ',');
+        } else if (option == "--map") {
+            mapPaths.push_back(value);
+        } else if (option == "--map-format") {
+            mapFormatName = value;
+        } else if (option == "--runs") {
+            runCount = static_cast<size_t>(std::max(1l, std::atol(value.c_str())));
+        } else if (option == "--filter") {
+            filter = value;
+        } else if (option == "--format") {
+            format = value;
+        } else if (option == "--output") {
+            outputPath = value;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (format != "json" && format != "csv") {
+        std::cerr << "Unknown result format: " << format << std::endl;
+        return 1;
+    }
+
+    const Model::MapFormat::Type mapFormat = Model::mapFormat(mapFormatName);
+    if (mapFormat == Model::MapFormat::Unknown) {
+        std::cerr << "Unknown map format: " << mapFormatName << std::endl;
+        return 1;
+    }
+
+    const BBox3 worldBounds(8192.0);
+    Benchmark::BenchmarkRunner runner(runCount, filter);
+
+    const Benchmark::MapGenerator generator(worldBounds);
+    for (const String& brushCount : brushCounts) {
+        const size_t count = static_cast<size_t>(std::atol(brushCount.c_str()));
+        if (count == 0 || count > generator.maxBrushCount()) {
+            std::cerr << "Invalid brush count: " << brushCount << std::endl;
+            return 1;
+        }
+
+        const String mapText = generator.generateMap(count);
+        Benchmark::runCoreBenchmarks(runner, "generated-" + brushCount, mapText, Model::MapFormat::Standard, worldBounds);
+    }
+
+    for (const String& mapPath : mapPaths) {
+        String mapText;
+        if (!readFile(mapPath, mapText)) {
+            std::cerr << "Cannot read map file: " << mapPath << std::endl;
+            return 1;
+        }
+        Benchmark::runCoreBenchmarks(runner, mapPath, mapText, mapFormat, worldBounds);
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath.c_str());
+        if (!file.is_open()) {
+            std::cerr << "Cannot write results to " << outputPath << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& output = outputPath.empty() ? std::cout : file;
+    if (format == "json")
+        runner.writeJson(output);
+    else
+        runner.writeCsv(output);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    wxApp* pApp = new TrenchBroom::View::TrenchBroomApp();
+    wxApp::SetInstance(pApp);
+    TrenchBroom::View::setCrashReportGUIEnbled(false);
+    ensure(wxEntryStart(argc, argv), "wxWidgets initialization failed");
+
+    // use an empty file config so that we always use the default preferences
+    wxConfig::Set(new wxFileConfig("TrenchBroom-Benchmark"));
+
+    // set the locale to US so that we can parse floats attribute
+    std::setlocale(LC_NUMERIC, "C");
+    const int result = runBenchmarks(argc, argv);
+
+    wxEntryCleanup();
+    delete wxConfig::Set(NULL);
+
+    return result;
+}
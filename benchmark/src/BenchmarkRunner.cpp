@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        BenchmarkRunner::Result::Result(const String& i_benchmark, const String& i_map, const size_t i_brushCount, const size_t i_operationCount) :
+        benchmark(i_benchmark),
+        map(i_map),
+        brushCount(i_brushCount),
+        operationCount(i_operationCount),
+        runCount(0),
+        minTime(std::numeric_limits<double>::max()),
+        meanTime(0.0),
+        maxTime(0.0) {}
+
+        BenchmarkRunner::BenchmarkRunner(const size_t runCount, const String& filter) :
+        m_runCount(runCount),
+        m_filter(filter) {
+            assert(m_runCount > 0);
+        }
+
+        bool BenchmarkRunner::accepts(const String& benchmark) const {
+            return m_filter.empty() || benchmark.find(m_filter) != String::npos;
+        }
+
+        void BenchmarkRunner::run(const String& benchmark, const String& map, const size_t brushCount, const size_t operationCount, const Function& function) {
+            run(benchmark, map, brushCount, operationCount, Function(), function);
+        }
+
+        void BenchmarkRunner::run(const String& benchmark, const String& map, const size_t brushCount, const size_t operationCount, const Function& setup, const Function& function) {
+            if (!accepts(benchmark))
+                return;
+
+            typedef std::chrono::steady_clock Clock;
+
+            Result result(benchmark, map, brushCount, operationCount);
+            double totalTime = 0.0;
+            for (size_t i = 0; i < m_runCount; ++i) {
+                if (setup)
+                    setup();
+
+                const Clock::time_point start = Clock::now();
+                function();
+                const double time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+                result.minTime = std::min(result.minTime, time);
+                result.maxTime = std::max(result.maxTime, time);
+                totalTime += time;
+            }
+            result.runCount = m_runCount;
+            result.meanTime = totalTime / static_cast<double>(m_runCount);
+            m_results.push_back(result);
+
+            std::cerr << benchmark << " [" << map << "]: " << result.meanTime << " ms" << std::endl;
+        }
+
+        const BenchmarkRunner::ResultList& BenchmarkRunner::results() const {
+            return m_results;
+        }
+
+        static String escapeJson(const String& str) {
+            String result;
+            for (const char c : str) {
+                if (c == '"' || c == '\\')
+                    result.push_back('\\');
+                result.push_back(c);
+            }
+            return result;
+        }
+
+        void BenchmarkRunner::writeJson(std::ostream& str) const {
+            str << "{\n  \"results\": [";
+            for (size_t i = 0; i < m_results.size(); ++i) {
+                const Result& result = m_results[i];
+                str << (i > 0 ? "," : "") << "\n    {"
+                    << "\"benchmark\": \"" << escapeJson(result.benchmark) << "\", "
+                    << "\"map\": \"" << escapeJson(result.map) << "\", "
+                    << "\"brushes\": " << result.brushCount << ", "
+                    << "\"operations\": " << result.operationCount << ", "
+                    << "\"runs\": " << result.runCount << ", "
+                    << "\"min_ms\": " << result.minTime << ", "
+                    << "\"mean_ms\": " << result.meanTime << ", "
+                    << "\"max_ms\": " << result.maxTime << "}";
+            }
+            str << "\n  ]\n}" << std::endl;
+        }
+
+        void BenchmarkRunner::writeCsv(std::ostream& str) const {
+            str << "benchmark,map,brushes,operations,runs,min_ms,mean_ms,max_ms" << std::endl;
+            for (const Result& result : m_results) {
+                str << result.benchmark << ","
+                    << result.map << ","
+                    << result.brushCount << ","
+                    << result.operationCount << ","
+                    << result.runCount << ","
+                    << result.minTime << ","
+                    << result.meanTime << ","
+                    << result.maxTime << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BenchmarkRunner
+#define TrenchBroom_BenchmarkRunner
+
+#include "StringUtils.h"
+
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        /**
+         Runs benchmarks and collects their timings. Each benchmark is run a fixed number of times. Before each run, an
+         optional setup function is called whose time is not measured.
+         */
+        class BenchmarkRunner {
+        public:
+            typedef std::function<void()> Function;
+
+            struct Result {
+                String benchmark;
+                String map;
+                size_t brushCount;
+                size_t operationCount;
+                size_t runCount;
+                double minTime;
+                double meanTime;
+                double maxTime;
+
+                Result(const String& i_benchmark, const String& i_map, size_t i_brushCount, size_t i_operationCount);
+            };
+            typedef std::vector<Result> ResultList;
+        private:
+            size_t m_runCount;
+            String m_filter;
+            ResultList m_results;
+        public:
+            BenchmarkRunner(size_t runCount, const String& filter);
+
+            /**
+             Indicates whether the benchmark with the given name passes the filter. Use this to skip expensive setup
+             of filtered benchmarks.
+             */
+            bool accepts(const String& benchmark) const;
+
+            /**
+             Runs the given benchmark on the given map unless it is filtered. The operation count is the number of
+             operations that one run performs, e.g. the number of rays for a pick benchmark.
+             */
+            void run(const String& benchmark, const String& map, size_t brushCount, size_t operationCount, const Function& function);
+            void run(const String& benchmark, const String& map, size_t brushCount, size_t operationCount, const Function& setup, const Function& function);
+
+            const ResultList& results() const;
+
+            void writeJson(std::ostream& str) const;
+            void writeCsv(std::ostream& str) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_BenchmarkRunner) */
@@ -0,0 +1,294 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CoreBenchmarks.h"
+
+#include "BenchmarkRunner.h"
+#include "CollectionUtils.h"
+#include "GL/GLMock.h"
+#include "IO/NodeWriter.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/AssortNodesVisitor.h"
+#include "Model/AttributeNameWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/AttributeValueWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/EditorContext.h"
+#include "Model/EmptyAttributeNameIssueGenerator.h"
+#include "Model/EmptyAttributeValueIssueGenerator.h"
+#include "Model/EmptyBrushEntityIssueGenerator.h"
+#include "Model/EmptyGroupIssueGenerator.h"
+#include "Model/LinkSourceIssueGenerator.h"
+#include "Model/LinkTargetIssueGenerator.h"
+#include "Model/LongAttributeNameIssueGenerator.h"
+#include "Model/LongAttributeValueIssueGenerator.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/MissingDefinitionIssueGenerator.h"
+#include "Model/MixedBrushContentsIssueGenerator.h"
+#include "Model/ModelUtils.h"
+#include "Model/NonIntegerPlanePointsIssueGenerator.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/PickResult.h"
+#include "Model/PointEntityWithBrushesIssueGenerator.h"
+#include "Model/World.h"
+#include "Model/WorldBoundsIssueGenerator.h"
+#include "Renderer/BrushRenderer.h"
+#include "Renderer/FontManager.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "Renderer/RenderBatch.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/ShaderManager.h"
+#include "Renderer/Vbo.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        static const size_t SampleCount = 1000;
+
+        /**
+         Stands in for the buffer objects of the mocked OpenGL functions, so that VBOs can be mapped and written to.
+         */
+        class GLBufferStorage {
+        private:
+            typedef std::vector<unsigned char> Buffer;
+            std::map<GLenum, Buffer> m_buffers;
+        public:
+            void bufferData(const GLenum target, const GLsizeiptr size, const GLvoid* data, const GLenum usage) {
+                m_buffers[target].resize(static_cast<size_t>(size));
+            }
+
+            void* mapBuffer(const GLenum target, const GLenum access) {
+                return m_buffers[target].data();
+            }
+        };
+
+        static Model::World* readWorld(const String& mapText, const Model::MapFormat::Type format, const BBox3& worldBounds) {
+            IO::SimpleParserStatus status(NULL);
+            IO::WorldReader reader(mapText, NULL);
+            return reader.read(format, worldBounds, status);
+        }
+
+        static Model::BrushList collectBrushes(Model::World* world) {
+            Model::CollectBrushesVisitor collect;
+            world->acceptAndRecurse(collect);
+            return collect.brushes();
+        }
+
+        static Model::BrushList sampleBrushes(const Model::BrushList& brushes, const size_t count) {
+            if (brushes.size() <= count)
+                return brushes;
+
+            Model::BrushList result;
+            result.reserve(count);
+            const size_t stride = brushes.size() / count;
+            for (size_t i = 0; i < count; ++i)
+                result.push_back(brushes[i * stride]);
+            return result;
+        }
+
+        static BBox3 mergeBounds(const Model::BrushList& brushes) {
+            if (brushes.empty())
+                return BBox3();
+
+            BBox3 bounds = brushes.front()->bounds();
+            for (const Model::Brush* brush : brushes)
+                bounds.mergeWith(brush->bounds());
+            return bounds;
+        }
+
+        static void registerIssueGenerators(Model::World* world, const BBox3& worldBounds) {
+            // the missing mod generator is left out because it needs a game
+            world->unregisterAllIssueGenerators();
+            world->registerIssueGenerator(new Model::MissingClassnameIssueGenerator());
+            world->registerIssueGenerator(new Model::MissingDefinitionIssueGenerator());
+            world->registerIssueGenerator(new Model::EmptyGroupIssueGenerator());
+            world->registerIssueGenerator(new Model::EmptyBrushEntityIssueGenerator());
+            world->registerIssueGenerator(new Model::PointEntityWithBrushesIssueGenerator());
+            world->registerIssueGenerator(new Model::LinkSourceIssueGenerator());
+            world->registerIssueGenerator(new Model::LinkTargetIssueGenerator());
+            world->registerIssueGenerator(new Model::NonIntegerPlanePointsIssueGenerator());
+            world->registerIssueGenerator(new Model::NonIntegerVerticesIssueGenerator());
+            world->registerIssueGenerator(new Model::MixedBrushContentsIssueGenerator());
+            world->registerIssueGenerator(new Model::WorldBoundsIssueGenerator(worldBounds));
+            world->registerIssueGenerator(new Model::EmptyAttributeNameIssueGenerator());
+            world->registerIssueGenerator(new Model::EmptyAttributeValueIssueGenerator());
+            world->registerIssueGenerator(new Model::LongAttributeNameIssueGenerator(1023));
+            world->registerIssueGenerator(new Model::LongAttributeValueIssueGenerator(1023));
+            world->registerIssueGenerator(new Model::AttributeNameWithDoubleQuotationMarksIssueGenerator());
+            world->registerIssueGenerator(new Model::AttributeValueWithDoubleQuotationMarksIssueGenerator());
+        }
+
+        static void runParseBenchmark(BenchmarkRunner& runner, const String& mapName, const String& mapText, const Model::MapFormat::Type format, const BBox3& worldBounds, const size_t brushCount) {
+            Model::World* world = NULL;
+            runner.run("parse", mapName, brushCount, brushCount,
+                       [&world]() { delete world; world = NULL; },
+                       [&world, &mapText, format, &worldBounds]() { world = readWorld(mapText, format, worldBounds); });
+            delete world;
+        }
+
+        static void runGeometryBenchmark(BenchmarkRunner& runner, const String& mapName, const Model::BrushList& brushes, const BBox3& worldBounds) {
+            runner.run("build geometry", mapName, brushes.size(), brushes.size(), [&brushes, &worldBounds]() {
+                for (const Model::Brush* brush : brushes) {
+                    Model::BrushFaceList faces;
+                    faces.reserve(brush->faceCount());
+                    for (const Model::BrushFace* face : brush->faces())
+                        faces.push_back(face->clone());
+                    delete new Model::Brush(worldBounds, faces);
+                }
+            });
+        }
+
+        static void runSerializeBenchmark(BenchmarkRunner& runner, const String& mapName, Model::World* world, const size_t brushCount) {
+            runner.run("serialize", mapName, brushCount, brushCount, [world]() {
+                std::stringstream str;
+                IO::NodeWriter writer(world, str);
+                writer.writeMap();
+            });
+        }
+
+        static void runPickBenchmark(BenchmarkRunner& runner, const String& mapName, Model::World* world, const Model::BrushList& brushes) {
+            // cast rays from random points above the map straight down
+            const BBox3 bounds = mergeBounds(brushes);
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> x(bounds.min.x(), bounds.max.x());
+            std::uniform_real_distribution<FloatType> y(bounds.min.y(), bounds.max.y());
+
+            std::vector<Ray3> rays;
+            rays.reserve(SampleCount);
+            for (size_t i = 0; i < SampleCount; ++i)
+                rays.push_back(Ray3(Vec3(x(random), y(random), bounds.max.z() + 16.0), Vec3::NegZ));
+
+            const Model::EditorContext editorContext;
+            runner.run("pick", mapName, brushes.size(), rays.size(), [world, &rays, &editorContext]() {
+                for (const Ray3& ray : rays) {
+                    Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
+                    world->pick(ray, pickResult);
+                }
+            });
+        }
+
+        static void runCsgBenchmark(BenchmarkRunner& runner, const String& mapName, Model::World* world, const Model::BrushList& brushes, const BBox3& worldBounds) {
+            if (!runner.accepts("csg subtract"))
+                return;
+
+            // each sampled brush is cut by a cuboid that overlaps one of its corners
+            const Model::BrushList minuends = sampleBrushes(brushes, SampleCount);
+            const Model::BrushBuilder builder(world, worldBounds);
+            Model::BrushList subtrahends;
+            subtrahends.reserve(minuends.size());
+            for (const Model::Brush* minuend : minuends) {
+                const BBox3& bounds = minuend->bounds();
+                subtrahends.push_back(builder.createCuboid(BBox3(bounds.center(), bounds.max + Vec3(8.0, 8.0, 8.0)), "cutter"));
+            }
+
+            runner.run("csg subtract", mapName, brushes.size(), minuends.size(), [world, &minuends, &subtrahends, &worldBounds]() {
+                for (size_t i = 0; i < minuends.size(); ++i) {
+                    Model::BrushList result = minuends[i]->subtract(*world, worldBounds, "cutter", subtrahends[i]);
+                    VectorUtils::clearAndDelete(result);
+                }
+            });
+
+            VectorUtils::clearAndDelete(subtrahends);
+        }
+
+        static void runVertexMoveBenchmark(BenchmarkRunner& runner, const String& mapName, const Model::BrushList& brushes, const BBox3& worldBounds) {
+            const Model::BrushList samples = sampleBrushes(brushes, SampleCount);
+            const Vec3 delta(-4.0, -4.0, -4.0);
+
+            // the brushes are cloned before each run because moving a vertex changes the brush
+            Model::BrushList clones;
+            runner.run("move vertices", mapName, brushes.size(), samples.size(),
+                       [&clones, &samples, &worldBounds]() {
+                           VectorUtils::clearAndDelete(clones);
+                           for (const Model::Brush* brush : samples)
+                               clones.push_back(brush->clone(worldBounds));
+                       },
+                       [&clones, &worldBounds, &delta]() {
+                           for (Model::Brush* brush : clones) {
+                               const Vec3::List vertices(1, brush->bounds().max);
+                               if (brush->canMoveVertices(worldBounds, vertices, delta))
+                                   brush->moveVertices(worldBounds, vertices, delta);
+                           }
+                       });
+            VectorUtils::clearAndDelete(clones);
+        }
+
+        static void runIssueBenchmark(BenchmarkRunner& runner, const String& mapName, Model::World* world, const size_t brushCount, const BBox3& worldBounds) {
+            // registering the generators invalidates all issues
+            runner.run("generate issues", mapName, brushCount, brushCount,
+                       [world, &worldBounds]() { registerIssueGenerators(world, worldBounds); },
+                       [world]() { Model::validateIssues(world, world->registeredIssueGenerators()); });
+            world->unregisterAllIssueGenerators();
+        }
+
+        static void runRenderBenchmark(BenchmarkRunner& runner, const String& mapName, const Model::BrushList& brushes) {
+            if (!runner.accepts("prepare render batch"))
+                return;
+
+            using namespace testing;
+            NiceMock<GLMock> glMock;
+            GLBufferStorage storage;
+            ON_CALL(glMock, GenBuffers(_, _)).WillByDefault(SetArgumentPointee<1>(1));
+            ON_CALL(glMock, BufferData(_, _, _, _)).WillByDefault(Invoke(&storage, &GLBufferStorage::bufferData));
+            ON_CALL(glMock, MapBuffer(_, _)).WillByDefault(Invoke(&storage, &GLBufferStorage::mapBuffer));
+            ON_CALL(glMock, UnmapBuffer(_)).WillByDefault(Return(GL_TRUE));
+
+            Renderer::PerspectiveCamera camera;
+            Renderer::FontManager fontManager;
+            Renderer::ShaderManager shaderManager;
+            Renderer::RenderContext renderContext(Renderer::RenderContext::RenderMode_3D, camera, fontManager, shaderManager);
+
+            // the renderer is rebuilt in every run and its vertices and indices are uploaded into fresh buffers
+            Renderer::BrushRenderer renderer(false);
+            renderer.setBrushes(brushes);
+            runner.run("prepare render batch", mapName, brushes.size(), brushes.size(),
+                       [&renderer]() { renderer.invalidate(); },
+                       [&renderer, &renderContext]() {
+                           Renderer::Vbo vertexVbo(0xFFFFF);
+                           Renderer::Vbo indexVbo(0xFFFFF, GL_ELEMENT_ARRAY_BUFFER);
+                           Renderer::RenderBatch renderBatch(vertexVbo, indexVbo);
+                           renderer.render(renderContext, renderBatch);
+                           renderBatch.prepare();
+                       });
+        }
+
+        void runCoreBenchmarks(BenchmarkRunner& runner, const String& mapName, const String& mapText, const Model::MapFormat::Type format, const BBox3& worldBounds) {
+            Model::World* world = readWorld(mapText, format, worldBounds);
+            const Model::BrushList brushes = collectBrushes(world);
+
+            runParseBenchmark(runner, mapName, mapText, format, worldBounds, brushes.size());
+            runGeometryBenchmark(runner, mapName, brushes, worldBounds);
+            runSerializeBenchmark(runner, mapName, world, brushes.size());
+            runPickBenchmark(runner, mapName, world, brushes);
+            runCsgBenchmark(runner, mapName, world, brushes, worldBounds);
+            runVertexMoveBenchmark(runner, mapName, brushes, worldBounds);
+            runIssueBenchmark(runner, mapName, world, brushes.size(), worldBounds);
+            runRenderBenchmark(runner, mapName, brushes);
+
+            delete world;
+        }
+    }
+}
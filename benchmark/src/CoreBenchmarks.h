@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_CoreBenchmarks
+#define TrenchBroom_CoreBenchmarks
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "StringUtils.h"
+#include "Model/MapFormat.h"
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        class BenchmarkRunner;
+
+        /**
+         Runs the core benchmarks on the given map: parsing, building brush geometry, serializing, picking, CSG
+         subtraction, vertex moves, issue generation and preparing the brushes for rendering. Operations that do not
+         scale with the map, such as picking, use a fixed number of samples.
+         */
+        void runCoreBenchmarks(BenchmarkRunner& runner, const String& mapName, const String& mapText, Model::MapFormat::Type format, const BBox3& worldBounds);
+    }
+}
+
+#endif /* defined(TrenchBroom_CoreBenchmarks) */
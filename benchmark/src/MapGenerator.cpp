@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapGenerator.h"
+
+#include "Exceptions.h"
+#include "IO/NodeWriter.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Entity.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace Benchmark {
+        const FloatType MapGenerator::CellSize = 128.0;
+
+        // every n-th brush belongs to a brush entity, and every n-th cell also contains a point entity
+        static const size_t BrushEntityInterval = 32;
+        static const size_t PointEntityInterval = 64;
+        static const size_t TextureCount = 16;
+
+        static String indexedName(const String& prefix, const size_t index) {
+            StringStream str;
+            str << prefix << index;
+            return str.str();
+        }
+
+        MapGenerator::MapGenerator(const BBox3& worldBounds, const unsigned int seed) :
+        m_worldBounds(worldBounds),
+        m_seed(seed) {}
+
+        size_t MapGenerator::maxBrushCount() const {
+            const Vec3 size = m_worldBounds.size();
+            const FloatType minSize = std::min(std::min(size.x(), size.y()), size.z());
+            const size_t cellsPerAxis = static_cast<size_t>(std::floor(minSize / CellSize));
+            return cellsPerAxis * cellsPerAxis * cellsPerAxis;
+        }
+
+        Model::World* MapGenerator::generateWorld(const size_t brushCount) const {
+            if (brushCount > maxBrushCount()) {
+                GeometryException e;
+                e << brushCount << " brushes do not fit into the world bounds";
+                throw e;
+            }
+
+            size_t cellsPerAxis = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(brushCount))));
+            while (cellsPerAxis * cellsPerAxis * cellsPerAxis < brushCount)
+                ++cellsPerAxis;
+
+            std::mt19937 random(m_seed);
+            std::uniform_int_distribution<int> sizeDistribution(2, static_cast<int>(CellSize / 16.0));
+            std::uniform_int_distribution<size_t> textureDistribution(0, TextureCount - 1);
+
+            Model::World* world = new Model::World(Model::MapFormat::Standard, NULL, m_worldBounds);
+            Model::Layer* layer = world->defaultLayer();
+            const Model::BrushBuilder builder(world, m_worldBounds);
+
+            // center the grid in the world bounds
+            const FloatType gridSize = static_cast<FloatType>(cellsPerAxis) * CellSize;
+            const Vec3 gridOrigin = m_worldBounds.center() - Vec3(gridSize, gridSize, gridSize) / 2.0;
+
+            Model::Entity* brushEntity = NULL;
+            for (size_t i = 0; i < brushCount; ++i) {
+                const size_t x = i % cellsPerAxis;
+                const size_t y = (i / cellsPerAxis) % cellsPerAxis;
+                const size_t z = i / (cellsPerAxis * cellsPerAxis);
+                const Vec3 cellOrigin = gridOrigin + Vec3(static_cast<FloatType>(x), static_cast<FloatType>(y), static_cast<FloatType>(z)) * CellSize;
+
+                // brushes keep a quarter of the cell size away from the cell boundaries
+                const Vec3 min = cellOrigin + Vec3(CellSize, CellSize, CellSize) / 4.0;
+                const Vec3 size(8.0 * sizeDistribution(random),
+                                8.0 * sizeDistribution(random),
+                                8.0 * sizeDistribution(random));
+                const String texture = indexedName("texture", textureDistribution(random));
+                Model::Brush* brush = builder.createCuboid(BBox3(min, min + size), texture);
+
+                if (i % BrushEntityInterval == 0) {
+                    brushEntity = world->createEntity();
+                    brushEntity->addOrUpdateAttribute(Model::AttributeNames::Classname, "func_wall");
+                    layer->addChild(brushEntity);
+                }
+
+                if (i % BrushEntityInterval < BrushEntityInterval / 4)
+                    brushEntity->addChild(brush);
+                else
+                    layer->addChild(brush);
+
+                if (i % PointEntityInterval == 0) {
+                    const size_t index = i / PointEntityInterval;
+                    Model::Entity* pointEntity = world->createEntity();
+                    pointEntity->addOrUpdateAttribute(Model::AttributeNames::Classname, "light");
+                    pointEntity->addOrUpdateAttribute(Model::AttributeNames::Origin, cellOrigin + Vec3(8.0, 8.0, 8.0));
+                    pointEntity->addOrUpdateAttribute(Model::AttributeNames::Targetname, indexedName("t", index));
+                    pointEntity->addOrUpdateAttribute(Model::AttributeNames::Target, indexedName("t", index + 1));
+                    layer->addChild(pointEntity);
+                }
+            }
+
+            return world;
+        }
+
+        String MapGenerator::generateMap(const size_t brushCount) const {
+            Model::World* world = generateWorld(brushCount);
+
+            std::stringstream str;
+            IO::NodeWriter writer(world, str);
+            writer.writeMap();
+
+            delete world;
+            return str.str();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapGenerator
+#define TrenchBroom_MapGenerator
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "StringUtils.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        class World;
+    }
+
+    namespace Benchmark {
+        /**
+         Generates synthetic maps in the standard Quake format. The brushes are cuboids of random size that are laid out
+         on a grid without overlapping each other. Some of them belong to brush entities, and the map also contains
+         point entities that are linked to each other. The same brush count and seed always yield the same map.
+         */
+        class MapGenerator {
+        private:
+            BBox3 m_worldBounds;
+            unsigned int m_seed;
+        public:
+            static const FloatType CellSize;
+
+            MapGenerator(const BBox3& worldBounds, unsigned int seed = 0);
+
+            /**
+             Returns the largest brush count that fits into the world bounds.
+             */
+            size_t maxBrushCount() const;
+
+            Model::World* generateWorld(size_t brushCount) const;
+            String generateMap(size_t brushCount) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapGenerator) */
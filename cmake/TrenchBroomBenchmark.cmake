@@ -0,0 +1,23 @@
+SET(BENCHMARK_SOURCE_DIR "${CMAKE_SOURCE_DIR}/benchmark/src")
+
+FILE(GLOB_RECURSE BENCHMARK_SOURCE
+    "${BENCHMARK_SOURCE_DIR}/*.h"
+    "${BENCHMARK_SOURCE_DIR}/*.cpp"
+)
+
+# The benchmarks render against the mocked OpenGL functions of the unit tests, so no GL context is needed
+SET(BENCHMARK_GL_MOCK_SOURCE
+    "${TEST_SOURCE_DIR}/GL/GLMock.h"
+    "${TEST_SOURCE_DIR}/GL/GLMock.cpp"
+)
+
+ADD_EXECUTABLE(TrenchBroom-Benchmark ${BENCHMARK_SOURCE} ${BENCHMARK_GL_MOCK_SOURCE} $<TARGET_OBJECTS:common>)
+
+ADD_TARGET_PROPERTY(TrenchBroom-Benchmark INCLUDE_DIRECTORIES "${BENCHMARK_SOURCE_DIR}")
+ADD_TARGET_PROPERTY(TrenchBroom-Benchmark INCLUDE_DIRECTORIES "${TEST_SOURCE_DIR}")
+TARGET_LINK_LIBRARIES(TrenchBroom-Benchmark gtest gmock ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+IF (COMPILER_IS_MSVC)
+    TARGET_LINK_LIBRARIES(TrenchBroom-Benchmark stackwalker)
+ENDIF()
+
+SET_XCODE_ATTRIBUTES(TrenchBroom-Benchmark)
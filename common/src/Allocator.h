@@ -20,10 +20,12 @@
 #ifndef TrenchBroom_Allocator_h
 #define TrenchBroom_Allocator_h
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <limits>
-#include <stack>
+#include <mutex>
 #include <vector>
 
 // Undefine this to prevent false positives when looking for memory leaks.
@@ -87,14 +89,81 @@ private:
         bool full() const {
             return m_numFreeBlocks == 0;
         }
+        
+        size_t usedBlockCount() const {
+            return BlocksPerChunk - 1 - m_numFreeBlocks;
+        }
     };
     
     typedef std::vector<Chunk*> ChunkList;
-    typedef std::stack<T*> Pool;
     
-    static Pool& pool() {
-        static Pool p;
-        return p;
+    /**
+     Caches free blocks for the current thread so that most allocations and deallocations do not have to take the
+     lock. Blocks move between the cache and the chunks in batches of PoolSize blocks. A block may be freed on another
+     thread than the one that allocated it; it then ends up in the cache of the freeing thread.
+     */
+    class ThreadCache {
+    private:
+        std::vector<T*> m_blocks;
+        // read by usedMemory on other threads
+        std::atomic<size_t> m_size;
+    public:
+        ThreadCache() :
+        m_size(0) {
+            m_blocks.reserve(2 * PoolSize + 1);
+            std::lock_guard<std::mutex> lock(mutex());
+            threadCaches().push_back(this);
+        }
+        
+        ~ThreadCache() {
+            std::lock_guard<std::mutex> lock(mutex());
+            for (T* block : m_blocks)
+                deallocateBlock(block);
+            
+            ThreadCacheList& caches = threadCaches();
+            caches.erase(std::find(std::begin(caches), std::end(caches), this));
+        }
+        
+        size_t size() const {
+            return m_size.load(std::memory_order_relaxed);
+        }
+        
+        T* allocate() {
+            if (m_blocks.empty()) {
+                std::lock_guard<std::mutex> lock(mutex());
+                for (size_t i = 0; i < PoolSize; ++i)
+                    m_blocks.push_back(allocateBlock());
+            }
+            
+            T* block = m_blocks.back();
+            m_blocks.pop_back();
+            m_size.store(m_blocks.size(), std::memory_order_relaxed);
+            return block;
+        }
+        
+        void deallocate(T* block) {
+            m_blocks.push_back(block);
+            if (m_blocks.size() > 2 * PoolSize) {
+                std::lock_guard<std::mutex> lock(mutex());
+                while (m_blocks.size() > PoolSize) {
+                    deallocateBlock(m_blocks.back());
+                    m_blocks.pop_back();
+                }
+            }
+            m_size.store(m_blocks.size(), std::memory_order_relaxed);
+        }
+    };
+    
+    typedef std::vector<ThreadCache*> ThreadCacheList;
+    
+    static ThreadCache& threadCache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+    
+    static ThreadCacheList& threadCaches() {
+        static ThreadCacheList caches;
+        return caches;
     }
     
     static ChunkList& fullChunks() {
@@ -107,21 +176,20 @@ private:
         return chunks;
     }
     
-    static ChunkList emptyChunks() {
+    static ChunkList& emptyChunks() {
         static ChunkList chunks;
         return chunks;
     }
-public:
-#ifdef TB_ENABLE_ALLOCATOR
-    void* operator new(size_t size) {
-        assert(size == sizeof(T));
-        
-        if (!pool().empty()) {
-            T* t = pool().top();
-            pool().pop();
-            return t;
-        }
-        
+
+    // Polyhedra may be built concurrently on worker threads, so the chunk lists are guarded by a lock. The lock is
+    // only taken when a thread cache runs empty or overflows.
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+    
+    // must be called with the lock held
+    static T* allocateBlock() {
         Chunk* chunk = NULL;
         if (mixedChunks().empty()) {
             if (!emptyChunks().empty()) {
@@ -140,19 +208,13 @@ public:
         
         if (chunk->full())
             fullChunks().push_back(chunk);
-            else
-                mixedChunks().push_back(chunk);
-                return block;
+        else
+            mixedChunks().push_back(chunk);
+        return block;
     }
     
-    void operator delete(void* block) {
-        T* t = reinterpret_cast<T*>(block);
-        
-        if (PoolSize > 0 && pool().size() < PoolSize) {
-            pool().push(t);
-            return;
-        }
-        
+    // must be called with the lock held
+    static void deallocateBlock(T* t) {
         typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
         fullIt = fullChunks().rbegin();
         fullEnd = fullChunks().rend();
@@ -184,6 +246,7 @@ public:
         if (chunk->full()) {
             fullChunks().erase((fullIt + 1).base());
             mixedChunks().push_back(chunk);
+            mixedIt = mixedChunks().rbegin();
         }
         
         chunk->deallocate(t);
@@ -192,10 +255,40 @@ public:
             mixedChunks().erase((mixedIt + 1).base());
             if (emptyChunks().size() < 2)
                 emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
+            else
+                delete chunk;
         }
     }
+public:
+    /**
+     Returns the number of bytes reserved by the chunks of this allocator, including blocks that are not in use.
+     */
+    static size_t reservedMemory() {
+        std::lock_guard<std::mutex> lock(mutex());
+        return (fullChunks().size() + mixedChunks().size() + emptyChunks().size()) * sizeof(Chunk);
+    }
+    
+    /**
+     Returns the number of bytes occupied by live objects allocated by this allocator.
+     */
+    static size_t usedMemory() {
+        std::lock_guard<std::mutex> lock(mutex());
+        size_t blockCount = fullChunks().size() * (BlocksPerChunk - 1);
+        for (const Chunk* chunk : mixedChunks())
+            blockCount += chunk->usedBlockCount();
+        for (const ThreadCache* cache : threadCaches())
+            blockCount -= cache->size();
+        return blockCount * sizeof(T);
+    }
+#ifdef TB_ENABLE_ALLOCATOR
+    void* operator new(size_t size) {
+        assert(size == sizeof(T));
+        return threadCache().allocate();
+    }
+    
+    void operator delete(void* block) {
+        threadCache().deallocate(reinterpret_cast<T*>(block));
+    }
 #endif
 };
 
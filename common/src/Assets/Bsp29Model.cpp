@@ -117,5 +117,14 @@ namespace TrenchBroom {
         void Bsp29Model::doSetTextureMode(const int minFilter, const int magFilter) {
             m_textureCollection->setTextureMode(minFilter, magFilter);
         }
+
+        size_t Bsp29Model::doGetMemoryUsage() const {
+            size_t result = m_textureCollection->memoryUsage();
+            for (const SubModel& subModel : m_subModels) {
+                for (const Face& face : subModel.faces)
+                    result += face.vertices().size() * sizeof(Face::Vertex);
+            }
+            return result;
+        }
     }
 }
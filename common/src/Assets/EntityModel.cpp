@@ -38,6 +38,10 @@ namespace TrenchBroom {
             return doGetTransformedBounds(skinIndex, frameIndex, transformation);
         }
 
+        size_t EntityModel::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+
         bool EntityModel::prepared() const {
             return m_prepared;
         }
@@ -39,6 +39,11 @@ namespace TrenchBroom {
             BBox3f bounds(const size_t skinIndex, const size_t frameIndex) const;
             BBox3f transformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const;
             
+            /**
+             Returns the memory used by the vertex and texture data of this model in bytes.
+             */
+            size_t memoryUsage() const;
+            
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
@@ -48,6 +53,7 @@ namespace TrenchBroom {
             virtual BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const = 0;
             virtual void doPrepare(int minFilter, int magFilter) = 0;
             virtual void doSetTextureMode(int minFilter, int magFilter) = 0;
+            virtual size_t doGetMemoryUsage() const = 0;
         };
     }
 }
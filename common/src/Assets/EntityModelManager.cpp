@@ -134,6 +134,19 @@ namespace TrenchBroom {
         bool EntityModelManager::hasModel(const Assets::ModelSpecification& spec) const {
             return renderer(spec) != nullptr;
         }
+        
+        size_t EntityModelManager::modelCount() const {
+            return m_models.size();
+        }
+        
+        size_t EntityModelManager::memoryUsage() const {
+            size_t result = 0;
+            for (const auto& entry : m_models) {
+                const EntityModel* model = entry.second;
+                result += model->memoryUsage();
+            }
+            return result;
+        }
 
         EntityModel* EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
@@ -82,6 +82,13 @@ namespace TrenchBroom {
             
             bool hasModel(const Model::Entity* entity) const;
             bool hasModel(const Assets::ModelSpecification& spec) const;
+            
+            size_t modelCount() const;
+            
+            /**
+             Returns the memory used by the vertex and texture data of all loaded models in bytes.
+             */
+            size_t memoryUsage() const;
         private:
             EntityModel* loadModel(const IO::Path& path) const;
         public:
@@ -112,5 +112,12 @@ namespace TrenchBroom {
         void Md2Model::doSetTextureMode(const int minFilter, const int magFilter) {
             m_skins->setTextureMode(minFilter, magFilter);
         }
+
+        size_t Md2Model::doGetMemoryUsage() const {
+            size_t result = m_skins->memoryUsage();
+            for (const Frame* frame : m_frames)
+                result += frame->vertices().size() * sizeof(Vertex);
+            return result;
+        }
     }
 }
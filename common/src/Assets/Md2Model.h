@@ -67,6 +67,7 @@ namespace TrenchBroom {
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const;
             void doPrepare(int minFilter, int magFilter);
             void doSetTextureMode(int minFilter, int magFilter);
+            size_t doGetMemoryUsage() const;
         };
     }
 }
@@ -53,6 +53,10 @@ namespace TrenchBroom {
             return m_textures.textures().front();
         }
 
+        size_t MdlSkin::memoryUsage() const {
+            return m_textures.memoryUsage();
+        }
+
         MdlBaseFrame::~MdlBaseFrame() {}
 
         MdlFrame::MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds) :
@@ -64,6 +68,10 @@ namespace TrenchBroom {
             return this;
         }
 
+        size_t MdlFrame::memoryUsage() const {
+            return m_triangles.size() * sizeof(Vertex);
+        }
+
         const MdlFrame::VertexList& MdlFrame::triangles() const {
             return m_triangles;
         }
@@ -101,6 +109,13 @@ namespace TrenchBroom {
             return m_frames[0]->firstFrame();
         }
         
+        size_t MdlFrameGroup::memoryUsage() const {
+            size_t result = 0;
+            for (const MdlFrame* frame : m_frames)
+                result += frame->memoryUsage();
+            return result;
+        }
+        
         void MdlFrameGroup::addFrame(MdlFrame* frame, const float time) {
             m_frames.push_back(frame);
             m_times.push_back(time);
@@ -165,5 +180,14 @@ namespace TrenchBroom {
             for (size_t i = 0; i < m_skins.size(); ++i)
                 m_skins[i]->setTextureMode(minFilter, magFilter);
         }
+
+        size_t MdlModel::doGetMemoryUsage() const {
+            size_t result = 0;
+            for (const MdlSkin* skin : m_skins)
+                result += skin->memoryUsage();
+            for (const MdlBaseFrame* frame : m_frames)
+                result += frame->memoryUsage();
+            return result;
+        }
     }
 }
@@ -46,6 +46,7 @@ namespace TrenchBroom {
             void prepare(int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
             const Texture* firstPicture() const;
+            size_t memoryUsage() const;
         };
 
         class MdlFrame;
@@ -54,6 +55,7 @@ namespace TrenchBroom {
         public:
             virtual ~MdlBaseFrame();
             virtual const MdlFrame* firstFrame() const = 0;
+            virtual size_t memoryUsage() const = 0;
         };
         
         class MdlFrame : public MdlBaseFrame {
@@ -67,6 +69,7 @@ namespace TrenchBroom {
         public:
             MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds);
             const MdlFrame* firstFrame() const;
+            size_t memoryUsage() const;
             const VertexList& triangles() const;
             BBox3f bounds() const;
             BBox3f transformedBounds(const Mat4x4f& transformation) const;
@@ -81,6 +84,7 @@ namespace TrenchBroom {
         public:
             ~MdlFrameGroup();
             const MdlFrame* firstFrame() const;
+            size_t memoryUsage() const;
             void addFrame(MdlFrame* frame, const float time);
         };
         
@@ -104,6 +108,7 @@ namespace TrenchBroom {
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const;
             void doPrepare(int minFilter, int magFilter);
             void doSetTextureMode(int minFilter, int magFilter);
+            size_t doGetMemoryUsage() const;
         };
     }
 }
@@ -34,6 +34,16 @@ namespace TrenchBroom {
             }
         }
 
+        static size_t bytesPerPixel(const GLenum format) {
+            switch (format) {
+                case GL_RGBA:
+                case GL_BGRA:
+                    return 4;
+                default:
+                    return 3;
+            }
+        }
+        
         Texture::Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer& buffer, const GLenum format) :
         m_collection(NULL),
         m_name(name),
@@ -43,7 +53,8 @@ namespace TrenchBroom {
         m_usageCount(0),
         m_overridden(false),
         m_format(format),
-        m_textureId(0) {
+        m_textureId(0),
+        m_uploadedSize(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * 3);
@@ -60,7 +71,8 @@ namespace TrenchBroom {
         m_overridden(false),
         m_format(format),
         m_textureId(0),
-        m_buffers(buffers) {
+        m_buffers(buffers),
+        m_uploadedSize(0) {
             assert(m_width > 0);
             assert(m_height > 0);
             for (size_t i = 0; i < m_buffers.size(); ++i) {
@@ -77,7 +89,8 @@ namespace TrenchBroom {
         m_usageCount(0),
         m_overridden(false),
         m_format(format),
-        m_textureId(0) {}
+        m_textureId(0),
+        m_uploadedSize(0) {}
 
         Texture::~Texture() {
             if (m_collection == NULL && m_textureId != 0)
@@ -126,6 +139,16 @@ namespace TrenchBroom {
             m_overridden = overridden;
         }
         
+        size_t Texture::memoryUsage() const {
+            if (m_buffers.empty())
+                return m_uploadedSize;
+
+            size_t result = 0;
+            for (const TextureBuffer& buffer : m_buffers)
+                result += buffer.size();
+            return result;
+        }
+        
         bool Texture::isPrepared() const {
             return m_textureId != 0;
         }
@@ -164,6 +187,7 @@ namespace TrenchBroom {
                                       static_cast<GLsizei>(mipWidth),
                                       static_cast<GLsizei>(mipHeight),
                                       0, m_format, GL_UNSIGNED_BYTE, data));
+                m_uploadedSize += mipWidth * mipHeight * bytesPerPixel(m_format);
                 mipWidth  /= 2;
                 mipHeight /= 2;
             }
@@ -51,6 +51,7 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable TextureBuffer::List m_buffers;
+            size_t m_uploadedSize;
         public:
             Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer& buffer, GLenum format = GL_RGB);
             Texture(const String& name, const size_t width, const size_t height, const Color& averageColor, const TextureBuffer::List& buffers, GLenum format = GL_RGB);
@@ -69,6 +70,12 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(const bool overridden);
 
+            /**
+             Returns the size of the image data of this texture in bytes, regardless of whether it is still held in
+             memory or has been uploaded to the GPU.
+             */
+            size_t memoryUsage() const;
+
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
@@ -85,6 +85,13 @@ namespace TrenchBroom {
             return m_textures;
         }
 
+        size_t TextureCollection::memoryUsage() const {
+            size_t result = 0;
+            for (const Texture* texture : m_textures)
+                result += texture->memoryUsage();
+            return result;
+        }
+
         size_t TextureCollection::usageCount() const {
             return m_usageCount;
         }
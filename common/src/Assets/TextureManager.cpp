@@ -141,6 +141,13 @@ namespace TrenchBroom {
             return m_collections;
         }
         
+        size_t TextureManager::memoryUsage() const {
+            size_t result = 0;
+            for (const TextureCollection* collection : m_collections)
+                result += collection->memoryUsage();
+            return result;
+        }
+        
         const StringList TextureManager::collectionNames() const {
             StringList result;
             result.reserve(m_collections.size());
@@ -75,6 +75,11 @@ namespace TrenchBroom {
             const TextureList& textures() const;
             const TextureCollectionList& collections() const;
             const StringList collectionNames() const;
+            
+            /**
+             Returns the size of the image data of all textures in the loaded collections in bytes.
+             */
+            size_t memoryUsage() const;
         private:
             void resetTextureMode();
             void prepare();
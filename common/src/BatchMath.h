@@ -0,0 +1,583 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_BatchMath_h
+#define TrenchBroom_BatchMath_h
+
+#include "BBox.h"
+#include "Mat.h"
+#include "MathUtils.h"
+#include "Plane.h"
+#include "Ray.h"
+#include "SIMD.h"
+#include "Vec.h"
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ Functions that operate on arrays of points, boxes and the like at once. Every function is available in a scalar
+ version in the namespace BatchMath::Scalar. The functions in the namespace BatchMath select a SIMD implementation for
+ float and double arguments if one is available for the current target, and fall back to the scalar implementation
+ otherwise. Both implementations return the same results.
+ */
+namespace BatchMath {
+    namespace Scalar {
+        /**
+         Transforms the given points by the given matrix, dividing the results by their w component.
+         */
+        template <typename T>
+        void transformPoints(const Mat<T,4,4>& transform, const Vec<T,3>* points, const size_t count, Vec<T,3>* result) {
+            for (size_t i = 0; i < count; ++i) {
+                Vec<T,4> p;
+                for (size_t r = 0; r < 4; ++r)
+                    for (size_t c = 0; c < 3; ++c)
+                        p[r] += transform[c][r] * points[i][c];
+                for (size_t r = 0; r < 4; ++r)
+                    p[r] += transform[3][r];
+                result[i] = Vec<T,3>(p[0] / p[3], p[1] / p[3], p[2] / p[3]);
+            }
+        }
+
+        /**
+         Computes the bounds of the given points. The given number of points must not be zero.
+         */
+        template <typename T, size_t S>
+        BBox<T,S> computeBounds(const Vec<T,S>* points, const size_t count) {
+            assert(count > 0);
+            BBox<T,S> result(points[0], points[0]);
+            for (size_t i = 1; i < count; ++i) {
+                for (size_t j = 0; j < S; ++j) {
+                    result.min[j] = std::min(result.min[j], points[i][j]);
+                    result.max[j] = std::max(result.max[j], points[i][j]);
+                }
+            }
+            return result;
+        }
+
+        /**
+         Computes the union of the given boxes. The given number of boxes must not be zero.
+         */
+        template <typename T, size_t S>
+        BBox<T,S> mergeBounds(const BBox<T,S>* boxes, const size_t count) {
+            assert(count > 0);
+            BBox<T,S> result = boxes[0];
+            for (size_t i = 1; i < count; ++i)
+                result.mergeWith(boxes[i]);
+            return result;
+        }
+
+        /**
+         Tests which of the given boxes intersect the given box. The result array receives one flag per box.
+         */
+        template <typename T, size_t S>
+        void intersectsBounds(const BBox<T,S>& bounds, const BBox<T,S>* boxes, const size_t count, bool* result) {
+            for (size_t i = 0; i < count; ++i)
+                result[i] = bounds.intersects(boxes[i]);
+        }
+
+        /**
+         Tests which of the given points are contained in the given box. The result array receives one flag per point.
+         */
+        template <typename T, size_t S>
+        void containsPoints(const BBox<T,S>& bounds, const Vec<T,S>* points, const size_t count, bool* result) {
+            for (size_t i = 0; i < count; ++i)
+                result[i] = bounds.contains(points[i]);
+        }
+
+        /**
+         Intersects the given ray with the given boxes using the slab test. For every box, the result array receives
+         the distance from the ray origin to the point where the ray enters the box, or the distance to the point where
+         the ray leaves the box if the origin is contained in it. If the ray misses a box, its distance is NaN. Returns
+         the number of boxes hit by the ray.
+         */
+        template <typename T>
+        size_t intersectBoundsWithRay(const Ray<T,3>& ray, const BBox<T,3>* boxes, const size_t count, T* result) {
+            const T inf = std::numeric_limits<T>::infinity();
+
+            size_t hits = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const BBox<T,3>& box = boxes[i];
+                T tNear = -inf;
+                T tFar  = +inf;
+                for (size_t j = 0; j < 3; ++j) {
+                    T tMin, tMax;
+                    if (ray.direction[j] == static_cast<T>(0.0)) {
+                        const bool inside = ray.origin[j] >= box.min[j] && ray.origin[j] <= box.max[j];
+                        tMin = inside ? -inf : +inf;
+                        tMax = inside ? +inf : -inf;
+                    } else {
+                        const T invDir = static_cast<T>(1.0) / ray.direction[j];
+                        const T t1 = (box.min[j] - ray.origin[j]) * invDir;
+                        const T t2 = (box.max[j] - ray.origin[j]) * invDir;
+                        tMin = std::min(t1, t2);
+                        tMax = std::max(t1, t2);
+                    }
+                    tNear = std::max(tNear, tMin);
+                    tFar  = std::min(tFar, tMax);
+                }
+
+                if (tFar < tNear || tFar < static_cast<T>(0.0)) {
+                    result[i] = Math::nan<T>();
+                } else {
+                    result[i] = tNear > static_cast<T>(0.0) ? tNear : tFar;
+                    ++hits;
+                }
+            }
+            return hits;
+        }
+
+        /**
+         Computes the signed distances of the given points to the given plane.
+         */
+        template <typename T>
+        void pointDistances(const Plane<T,3>& plane, const Vec<T,3>* points, const size_t count, T* result) {
+            for (size_t i = 0; i < count; ++i)
+                result[i] = plane.pointDistance(points[i]);
+        }
+    }
+
+#if defined(TB_SIMD_SSE2)
+    namespace SSE {
+        inline __m128 load3(const Vec<float,3>& v) {
+            return _mm_setr_ps(v[0], v[1], v[2], 0.0f);
+        }
+
+        inline void store3(const __m128 r, Vec<float,3>& v) {
+            _mm_storel_pi(reinterpret_cast<__m64*>(v.v), r);
+            _mm_store_ss(v.v + 2, _mm_movehl_ps(r, r));
+        }
+
+        inline __m128 select(const __m128 mask, const __m128 a, const __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        inline __m128d select(const __m128d mask, const __m128d a, const __m128d b) {
+            return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+        }
+
+        inline float hmin3(const __m128 r) {
+            const __m128 m = _mm_min_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1)));
+            return _mm_cvtss_f32(_mm_min_ss(m, _mm_movehl_ps(r, r)));
+        }
+
+        inline float hmax3(const __m128 r) {
+            const __m128 m = _mm_max_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1)));
+            return _mm_cvtss_f32(_mm_max_ss(m, _mm_movehl_ps(r, r)));
+        }
+
+        inline void transformPoints(const Mat<float,4,4>& transform, const Vec<float,3>* points, const size_t count, Vec<float,3>* result) {
+            const __m128 c0 = _mm_loadu_ps(transform[0].v);
+            const __m128 c1 = _mm_loadu_ps(transform[1].v);
+            const __m128 c2 = _mm_loadu_ps(transform[2].v);
+            const __m128 c3 = _mm_loadu_ps(transform[3].v);
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vec<float,3>& p = points[i];
+                __m128 r = _mm_mul_ps(c0, _mm_set1_ps(p[0]));
+                r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+                r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+                r = _mm_add_ps(r, c3);
+                r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+                store3(r, result[i]);
+            }
+        }
+
+        inline void transformPoints(const Mat<double,4,4>& transform, const Vec<double,3>* points, const size_t count, Vec<double,3>* result) {
+            const __m128d c0l = _mm_loadu_pd(transform[0].v), c0h = _mm_loadu_pd(transform[0].v + 2);
+            const __m128d c1l = _mm_loadu_pd(transform[1].v), c1h = _mm_loadu_pd(transform[1].v + 2);
+            const __m128d c2l = _mm_loadu_pd(transform[2].v), c2h = _mm_loadu_pd(transform[2].v + 2);
+            const __m128d c3l = _mm_loadu_pd(transform[3].v), c3h = _mm_loadu_pd(transform[3].v + 2);
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vec<double,3>& p = points[i];
+                const __m128d x = _mm_set1_pd(p[0]);
+                const __m128d y = _mm_set1_pd(p[1]);
+                const __m128d z = _mm_set1_pd(p[2]);
+
+                __m128d rl = _mm_mul_pd(c0l, x);
+                __m128d rh = _mm_mul_pd(c0h, x);
+                rl = _mm_add_pd(rl, _mm_mul_pd(c1l, y));
+                rh = _mm_add_pd(rh, _mm_mul_pd(c1h, y));
+                rl = _mm_add_pd(rl, _mm_mul_pd(c2l, z));
+                rh = _mm_add_pd(rh, _mm_mul_pd(c2h, z));
+                rl = _mm_add_pd(rl, c3l);
+                rh = _mm_add_pd(rh, c3h);
+
+                const __m128d w = _mm_unpackhi_pd(rh, rh);
+                _mm_storeu_pd(result[i].v, _mm_div_pd(rl, w));
+                _mm_store_sd(result[i].v + 2, _mm_div_pd(rh, w));
+            }
+        }
+
+        inline BBox<float,3> computeBounds(const Vec<float,3>* points, const size_t count) {
+            assert(count > 0);
+            __m128 min = load3(points[0]);
+            __m128 max = min;
+            for (size_t i = 1; i < count; ++i) {
+                const __m128 p = load3(points[i]);
+                min = _mm_min_ps(min, p);
+                max = _mm_max_ps(max, p);
+            }
+
+            BBox<float,3> result;
+            store3(min, result.min);
+            store3(max, result.max);
+            return result;
+        }
+
+        inline BBox<double,3> computeBounds(const Vec<double,3>* points, const size_t count) {
+            assert(count > 0);
+            __m128d minXY = _mm_loadu_pd(points[0].v);
+            __m128d minZ  = _mm_load_sd(points[0].v + 2);
+            __m128d maxXY = minXY;
+            __m128d maxZ  = minZ;
+            for (size_t i = 1; i < count; ++i) {
+                const __m128d pXY = _mm_loadu_pd(points[i].v);
+                const __m128d pZ  = _mm_load_sd(points[i].v + 2);
+                minXY = _mm_min_pd(minXY, pXY);
+                maxXY = _mm_max_pd(maxXY, pXY);
+                minZ  = _mm_min_sd(minZ, pZ);
+                maxZ  = _mm_max_sd(maxZ, pZ);
+            }
+
+            BBox<double,3> result;
+            _mm_storeu_pd(result.min.v, minXY);
+            _mm_store_sd(result.min.v + 2, minZ);
+            _mm_storeu_pd(result.max.v, maxXY);
+            _mm_store_sd(result.max.v + 2, maxZ);
+            return result;
+        }
+
+        inline BBox<float,3> mergeBounds(const BBox<float,3>* boxes, const size_t count) {
+            assert(count > 0);
+            __m128 min = load3(boxes[0].min);
+            __m128 max = load3(boxes[0].max);
+            for (size_t i = 1; i < count; ++i) {
+                min = _mm_min_ps(min, load3(boxes[i].min));
+                max = _mm_max_ps(max, load3(boxes[i].max));
+            }
+
+            BBox<float,3> result;
+            store3(min, result.min);
+            store3(max, result.max);
+            return result;
+        }
+
+        inline BBox<double,3> mergeBounds(const BBox<double,3>* boxes, const size_t count) {
+            assert(count > 0);
+            __m128d minXY = _mm_loadu_pd(boxes[0].min.v);
+            __m128d minZ  = _mm_load_sd(boxes[0].min.v + 2);
+            __m128d maxXY = _mm_loadu_pd(boxes[0].max.v);
+            __m128d maxZ  = _mm_load_sd(boxes[0].max.v + 2);
+            for (size_t i = 1; i < count; ++i) {
+                minXY = _mm_min_pd(minXY, _mm_loadu_pd(boxes[i].min.v));
+                minZ  = _mm_min_sd(minZ,  _mm_load_sd(boxes[i].min.v + 2));
+                maxXY = _mm_max_pd(maxXY, _mm_loadu_pd(boxes[i].max.v));
+                maxZ  = _mm_max_sd(maxZ,  _mm_load_sd(boxes[i].max.v + 2));
+            }
+
+            BBox<double,3> result;
+            _mm_storeu_pd(result.min.v, minXY);
+            _mm_store_sd(result.min.v + 2, minZ);
+            _mm_storeu_pd(result.max.v, maxXY);
+            _mm_store_sd(result.max.v + 2, maxZ);
+            return result;
+        }
+
+        inline void intersectsBounds(const BBox<float,3>& bounds, const BBox<float,3>* boxes, const size_t count, bool* result) {
+            const __m128 min = load3(bounds.min);
+            const __m128 max = load3(bounds.max);
+            for (size_t i = 0; i < count; ++i) {
+                const __m128 separated = _mm_or_ps(_mm_cmplt_ps(load3(boxes[i].max), min),
+                                                   _mm_cmpgt_ps(load3(boxes[i].min), max));
+                result[i] = _mm_movemask_ps(separated) == 0;
+            }
+        }
+
+        inline void intersectsBounds(const BBox<double,3>& bounds, const BBox<double,3>* boxes, const size_t count, bool* result) {
+            const __m128d minXY = _mm_loadu_pd(bounds.min.v);
+            const __m128d maxXY = _mm_loadu_pd(bounds.max.v);
+            const __m128d minZ  = _mm_set1_pd(bounds.min[2]);
+            const __m128d maxZ  = _mm_set1_pd(bounds.max[2]);
+            for (size_t i = 0; i < count; ++i) {
+                const BBox<double,3>& box = boxes[i];
+                const __m128d sepXY = _mm_or_pd(_mm_cmplt_pd(_mm_loadu_pd(box.max.v), minXY),
+                                                _mm_cmpgt_pd(_mm_loadu_pd(box.min.v), maxXY));
+                const __m128d sepZ  = _mm_or_pd(_mm_cmplt_pd(_mm_set1_pd(box.max[2]), minZ),
+                                                _mm_cmpgt_pd(_mm_set1_pd(box.min[2]), maxZ));
+                result[i] = _mm_movemask_pd(_mm_or_pd(sepXY, sepZ)) == 0;
+            }
+        }
+
+        inline void containsPoints(const BBox<float,3>& bounds, const Vec<float,3>* points, const size_t count, bool* result) {
+            const __m128 min = load3(bounds.min);
+            const __m128 max = load3(bounds.max);
+            for (size_t i = 0; i < count; ++i) {
+                const __m128 p = load3(points[i]);
+                const __m128 outside = _mm_or_ps(_mm_cmplt_ps(p, min), _mm_cmpgt_ps(p, max));
+                result[i] = _mm_movemask_ps(outside) == 0;
+            }
+        }
+
+        inline void containsPoints(const BBox<double,3>& bounds, const Vec<double,3>* points, const size_t count, bool* result) {
+            const __m128d minXY = _mm_loadu_pd(bounds.min.v);
+            const __m128d maxXY = _mm_loadu_pd(bounds.max.v);
+            const __m128d minZ  = _mm_set1_pd(bounds.min[2]);
+            const __m128d maxZ  = _mm_set1_pd(bounds.max[2]);
+            for (size_t i = 0; i < count; ++i) {
+                const __m128d pXY = _mm_loadu_pd(points[i].v);
+                const __m128d pZ  = _mm_set1_pd(points[i][2]);
+                const __m128d outXY = _mm_or_pd(_mm_cmplt_pd(pXY, minXY), _mm_cmpgt_pd(pXY, maxXY));
+                const __m128d outZ  = _mm_or_pd(_mm_cmplt_pd(pZ, minZ), _mm_cmpgt_pd(pZ, maxZ));
+                result[i] = _mm_movemask_pd(_mm_or_pd(outXY, outZ)) == 0;
+            }
+        }
+
+        inline size_t intersectBoundsWithRay(const Ray<float,3>& ray, const BBox<float,3>* boxes, const size_t count, float* result) {
+            const float inf = std::numeric_limits<float>::infinity();
+            const __m128 posInf = _mm_set1_ps(+inf);
+            const __m128 negInf = _mm_set1_ps(-inf);
+
+            // the unused fourth lane has a zero direction and a zero origin, and every box is padded with zeros, so that
+            // lane never restricts the intersection interval
+            const __m128 origin = load3(ray.origin);
+            const __m128 direction = load3(ray.direction);
+            const __m128 zeroDir = _mm_cmpeq_ps(direction, _mm_setzero_ps());
+            const __m128 invDir = _mm_div_ps(_mm_set1_ps(1.0f), direction);
+
+            size_t hits = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const __m128 min = load3(boxes[i].min);
+                const __m128 max = load3(boxes[i].max);
+
+                const __m128 t1 = _mm_mul_ps(_mm_sub_ps(min, origin), invDir);
+                const __m128 t2 = _mm_mul_ps(_mm_sub_ps(max, origin), invDir);
+                const __m128 inside = _mm_and_ps(_mm_cmpge_ps(origin, min), _mm_cmple_ps(origin, max));
+
+                const __m128 tMin = select(zeroDir, select(inside, negInf, posInf), _mm_min_ps(t1, t2));
+                const __m128 tMax = select(zeroDir, select(inside, posInf, negInf), _mm_max_ps(t1, t2));
+
+                const float tNear = hmax3(tMin);
+                const float tFar  = hmin3(tMax);
+                if (tFar < tNear || tFar < 0.0f) {
+                    result[i] = Math::nan<float>();
+                } else {
+                    result[i] = tNear > 0.0f ? tNear : tFar;
+                    ++hits;
+                }
+            }
+            return hits;
+        }
+
+        inline size_t intersectBoundsWithRay(const Ray<double,3>& ray, const BBox<double,3>* boxes, const size_t count, double* result) {
+            const double inf = std::numeric_limits<double>::infinity();
+            const __m128d posInf = _mm_set1_pd(+inf);
+            const __m128d negInf = _mm_set1_pd(-inf);
+
+            // the z component is duplicated into both lanes of the second register
+            const __m128d originXY = _mm_loadu_pd(ray.origin.v);
+            const __m128d originZ  = _mm_set1_pd(ray.origin[2]);
+            const __m128d dirXY = _mm_loadu_pd(ray.direction.v);
+            const __m128d dirZ  = _mm_set1_pd(ray.direction[2]);
+            const __m128d zeroDirXY = _mm_cmpeq_pd(dirXY, _mm_setzero_pd());
+            const __m128d zeroDirZ  = _mm_cmpeq_pd(dirZ, _mm_setzero_pd());
+            const __m128d invDirXY = _mm_div_pd(_mm_set1_pd(1.0), dirXY);
+            const __m128d invDirZ  = _mm_div_pd(_mm_set1_pd(1.0), dirZ);
+
+            size_t hits = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const BBox<double,3>& box = boxes[i];
+                const __m128d minXY = _mm_loadu_pd(box.min.v);
+                const __m128d maxXY = _mm_loadu_pd(box.max.v);
+                const __m128d minZ  = _mm_set1_pd(box.min[2]);
+                const __m128d maxZ  = _mm_set1_pd(box.max[2]);
+
+                const __m128d t1XY = _mm_mul_pd(_mm_sub_pd(minXY, originXY), invDirXY);
+                const __m128d t2XY = _mm_mul_pd(_mm_sub_pd(maxXY, originXY), invDirXY);
+                const __m128d t1Z  = _mm_mul_pd(_mm_sub_pd(minZ, originZ), invDirZ);
+                const __m128d t2Z  = _mm_mul_pd(_mm_sub_pd(maxZ, originZ), invDirZ);
+                const __m128d insideXY = _mm_and_pd(_mm_cmpge_pd(originXY, minXY), _mm_cmple_pd(originXY, maxXY));
+                const __m128d insideZ  = _mm_and_pd(_mm_cmpge_pd(originZ, minZ), _mm_cmple_pd(originZ, maxZ));
+
+                const __m128d tMinXY = select(zeroDirXY, select(insideXY, negInf, posInf), _mm_min_pd(t1XY, t2XY));
+                const __m128d tMaxXY = select(zeroDirXY, select(insideXY, posInf, negInf), _mm_max_pd(t1XY, t2XY));
+                const __m128d tMinZ  = select(zeroDirZ,  select(insideZ,  negInf, posInf), _mm_min_pd(t1Z, t2Z));
+                const __m128d tMaxZ  = select(zeroDirZ,  select(insideZ,  posInf, negInf), _mm_max_pd(t1Z, t2Z));
+
+                const __m128d nearXYZ = _mm_max_pd(tMinXY, tMinZ);
+                const __m128d farXYZ  = _mm_min_pd(tMaxXY, tMaxZ);
+                const double tNear = _mm_cvtsd_f64(_mm_max_sd(nearXYZ, _mm_unpackhi_pd(nearXYZ, nearXYZ)));
+                const double tFar  = _mm_cvtsd_f64(_mm_min_sd(farXYZ, _mm_unpackhi_pd(farXYZ, farXYZ)));
+                if (tFar < tNear || tFar < 0.0) {
+                    result[i] = Math::nan<double>();
+                } else {
+                    result[i] = tNear > 0.0 ? tNear : tFar;
+                    ++hits;
+                }
+            }
+            return hits;
+        }
+
+        inline void pointDistances(const Plane<float,3>& plane, const Vec<float,3>* points, const size_t count, float* result) {
+            const __m128 normal = load3(plane.normal);
+            for (size_t i = 0; i < count; ++i) {
+                const __m128 p = _mm_mul_ps(load3(points[i]), normal);
+                const float dot = _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 2, 0, 1))), _mm_movehl_ps(p, p)));
+                result[i] = dot - plane.distance;
+            }
+        }
+
+        inline void pointDistances(const Plane<double,3>& plane, const Vec<double,3>* points, const size_t count, double* result) {
+            const __m128d normalXY = _mm_loadu_pd(plane.normal.v);
+            const __m128d normalZ  = _mm_load_sd(plane.normal.v + 2);
+            for (size_t i = 0; i < count; ++i) {
+                const __m128d xy = _mm_mul_pd(_mm_loadu_pd(points[i].v), normalXY);
+                const __m128d z  = _mm_mul_sd(_mm_load_sd(points[i].v + 2), normalZ);
+                const double dot = _mm_cvtsd_f64(_mm_add_sd(_mm_add_sd(xy, _mm_unpackhi_pd(xy, xy)), z));
+                result[i] = dot - plane.distance;
+            }
+        }
+    }
+#endif
+
+    template <typename T>
+    void transformPoints(const Mat<T,4,4>& transform, const Vec<T,3>* points, const size_t count, Vec<T,3>* result) {
+        Scalar::transformPoints(transform, points, count, result);
+    }
+
+    template <typename T>
+    typename Vec<T,3>::List transformPoints(const Mat<T,4,4>& transform, const typename Vec<T,3>::List& points) {
+        typename Vec<T,3>::List result(points.size());
+        if (!points.empty())
+            transformPoints(transform, &points.front(), points.size(), &result.front());
+        return result;
+    }
+
+    template <typename T, size_t S>
+    BBox<T,S> computeBounds(const Vec<T,S>* points, const size_t count) {
+        return Scalar::computeBounds(points, count);
+    }
+
+    template <typename T, size_t S>
+    BBox<T,S> computeBounds(const std::vector<Vec<T,S> >& points) {
+        return computeBounds(&points.front(), points.size());
+    }
+
+    template <typename T, size_t S>
+    BBox<T,S> mergeBounds(const BBox<T,S>* boxes, const size_t count) {
+        return Scalar::mergeBounds(boxes, count);
+    }
+
+    template <typename T, size_t S>
+    void intersectsBounds(const BBox<T,S>& bounds, const BBox<T,S>* boxes, const size_t count, bool* result) {
+        Scalar::intersectsBounds(bounds, boxes, count, result);
+    }
+
+    template <typename T, size_t S>
+    void containsPoints(const BBox<T,S>& bounds, const Vec<T,S>* points, const size_t count, bool* result) {
+        Scalar::containsPoints(bounds, points, count, result);
+    }
+
+    template <typename T>
+    size_t intersectBoundsWithRay(const Ray<T,3>& ray, const BBox<T,3>* boxes, const size_t count, T* result) {
+        return Scalar::intersectBoundsWithRay(ray, boxes, count, result);
+    }
+
+    template <typename T>
+    void pointDistances(const Plane<T,3>& plane, const Vec<T,3>* points, const size_t count, T* result) {
+        Scalar::pointDistances(plane, points, count, result);
+    }
+
+#if defined(TB_SIMD_SSE2)
+    template <>
+    inline void transformPoints(const Mat<float,4,4>& transform, const Vec<float,3>* points, const size_t count, Vec<float,3>* result) {
+        SSE::transformPoints(transform, points, count, result);
+    }
+
+    template <>
+    inline void transformPoints(const Mat<double,4,4>& transform, const Vec<double,3>* points, const size_t count, Vec<double,3>* result) {
+        SSE::transformPoints(transform, points, count, result);
+    }
+
+    template <>
+    inline BBox<float,3> computeBounds(const Vec<float,3>* points, const size_t count) {
+        return SSE::computeBounds(points, count);
+    }
+
+    template <>
+    inline BBox<double,3> computeBounds(const Vec<double,3>* points, const size_t count) {
+        return SSE::computeBounds(points, count);
+    }
+
+    template <>
+    inline BBox<float,3> mergeBounds(const BBox<float,3>* boxes, const size_t count) {
+        return SSE::mergeBounds(boxes, count);
+    }
+
+    template <>
+    inline BBox<double,3> mergeBounds(const BBox<double,3>* boxes, const size_t count) {
+        return SSE::mergeBounds(boxes, count);
+    }
+
+    template <>
+    inline void intersectsBounds(const BBox<float,3>& bounds, const BBox<float,3>* boxes, const size_t count, bool* result) {
+        SSE::intersectsBounds(bounds, boxes, count, result);
+    }
+
+    template <>
+    inline void intersectsBounds(const BBox<double,3>& bounds, const BBox<double,3>* boxes, const size_t count, bool* result) {
+        SSE::intersectsBounds(bounds, boxes, count, result);
+    }
+
+    template <>
+    inline void containsPoints(const BBox<float,3>& bounds, const Vec<float,3>* points, const size_t count, bool* result) {
+        SSE::containsPoints(bounds, points, count, result);
+    }
+
+    template <>
+    inline void containsPoints(const BBox<double,3>& bounds, const Vec<double,3>* points, const size_t count, bool* result) {
+        SSE::containsPoints(bounds, points, count, result);
+    }
+
+    template <>
+    inline size_t intersectBoundsWithRay(const Ray<float,3>& ray, const BBox<float,3>* boxes, const size_t count, float* result) {
+        return SSE::intersectBoundsWithRay(ray, boxes, count, result);
+    }
+
+    template <>
+    inline size_t intersectBoundsWithRay(const Ray<double,3>& ray, const BBox<double,3>* boxes, const size_t count, double* result) {
+        return SSE::intersectBoundsWithRay(ray, boxes, count, result);
+    }
+
+    template <>
+    inline void pointDistances(const Plane<float,3>& plane, const Vec<float,3>* points, const size_t count, float* result) {
+        SSE::pointDistances(plane, points, count, result);
+    }
+
+    template <>
+    inline void pointDistances(const Plane<double,3>& plane, const Vec<double,3>* points, const size_t count, double* result) {
+        SSE::pointDistances(plane, points, count, result);
+    }
+#endif
+}
+
+#endif
@@ -457,11 +457,11 @@ public:
     void clear() {
         if (m_head != nullptr) {
             Item* item = m_head;
-            while (item != m_head) {
+            do {
                 Item* nextItem = next(item);
                 delete item;
                 item = nextItem;
-            }
+            } while (item != m_head);
             m_head = nullptr;
             m_size = 0;
             ++m_version;
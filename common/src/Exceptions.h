@@ -112,6 +112,11 @@ public:
     using ExceptionStream::ExceptionStream;
 };
 
+class AABBTreeException : public ExceptionStream<AABBTreeException> {
+public:
+    using ExceptionStream::ExceptionStream;
+};
+
 class GameException : public ExceptionStream<GameException> {
 public:
     using ExceptionStream::ExceptionStream;
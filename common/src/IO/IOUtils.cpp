@@ -78,6 +78,11 @@ namespace TrenchBroom {
             std::fprintf(stream, "// Format: %s\n", mapFormat.c_str());
         }
 
+        void writeGameComment(std::ostream& stream, const String& gameName, const String& mapFormat) {
+            stream << "// Game: " << gameName << "\n";
+            stream << "// Format: " << mapFormat << "\n";
+        }
+
         Vec3f readVec3f(const char*& cursor) {
             Vec3f value;
             for (size_t i = 0; i < 3; i++)
@@ -69,6 +69,7 @@ namespace TrenchBroom {
         String readInfoComment(std::istream& stream, const String& name);
         
         void writeGameComment(FILE* stream, const String& gameName, const String& mapFormat);
+        void writeGameComment(std::ostream& stream, const String& gameName, const String& mapFormat);
         
         template <typename T>
         void advance(const char*& cursor, const size_t i = 1) {
@@ -21,6 +21,7 @@
 #define TrenchBroom_Mat_h
 
 #include "Quat.h"
+#include "SIMD.h"
 #include "Vec.h"
 
 #include <algorithm>
@@ -263,6 +264,175 @@ public:
     }
 };
 
+#if defined(TB_SIMD_SSE2)
+// SIMD specializations of the 4x4 products, which dominate the cost of transforming brushes and of the camera and
+// picking computations. The summation order is the same as in the generic implementations above, so the results are
+// identical.
+
+template <>
+inline const Mat<float,4,4> Mat<float,4,4>::operator*(const Mat<float,4,4>& right) const {
+    const __m128 c0 = _mm_loadu_ps(v[0].v);
+    const __m128 c1 = _mm_loadu_ps(v[1].v);
+    const __m128 c2 = _mm_loadu_ps(v[2].v);
+    const __m128 c3 = _mm_loadu_ps(v[3].v);
+    
+    Mat<float,4,4> result;
+    for (size_t c = 0; c < 4; ++c) {
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(right[c][0]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(right[c][1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(right[c][2])));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(right[c][3])));
+        _mm_storeu_ps(result[c].v, r);
+    }
+    return result;
+}
+
+template <>
+inline const Vec<float,4> Mat<float,4,4>::operator*(const Vec<float,4>& right) const {
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(v[0].v), _mm_set1_ps(right[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(v[1].v), _mm_set1_ps(right[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(v[2].v), _mm_set1_ps(right[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(v[3].v), _mm_set1_ps(right[3])));
+    
+    Vec<float,4> result;
+    _mm_storeu_ps(result.v, r);
+    return result;
+}
+
+template <>
+inline const Vec<float,3> Mat<float,4,4>::operator*(const Vec<float,3>& right) const {
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(v[0].v), _mm_set1_ps(right[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(v[1].v), _mm_set1_ps(right[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(v[2].v), _mm_set1_ps(right[2])));
+    r = _mm_add_ps(r, _mm_loadu_ps(v[3].v));
+    r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+    
+    float buffer[4];
+    _mm_storeu_ps(buffer, r);
+    return Vec<float,3>(buffer[0], buffer[1], buffer[2]);
+}
+
+#if defined(TB_SIMD_AVX)
+template <>
+inline const Mat<double,4,4> Mat<double,4,4>::operator*(const Mat<double,4,4>& right) const {
+    const __m256d c0 = _mm256_loadu_pd(v[0].v);
+    const __m256d c1 = _mm256_loadu_pd(v[1].v);
+    const __m256d c2 = _mm256_loadu_pd(v[2].v);
+    const __m256d c3 = _mm256_loadu_pd(v[3].v);
+    
+    Mat<double,4,4> result;
+    for (size_t c = 0; c < 4; ++c) {
+        __m256d r = _mm256_mul_pd(c0, _mm256_set1_pd(right[c][0]));
+        r = _mm256_add_pd(r, _mm256_mul_pd(c1, _mm256_set1_pd(right[c][1])));
+        r = _mm256_add_pd(r, _mm256_mul_pd(c2, _mm256_set1_pd(right[c][2])));
+        r = _mm256_add_pd(r, _mm256_mul_pd(c3, _mm256_set1_pd(right[c][3])));
+        _mm256_storeu_pd(result[c].v, r);
+    }
+    return result;
+}
+
+template <>
+inline const Vec<double,4> Mat<double,4,4>::operator*(const Vec<double,4>& right) const {
+    __m256d r = _mm256_mul_pd(_mm256_loadu_pd(v[0].v), _mm256_set1_pd(right[0]));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(v[1].v), _mm256_set1_pd(right[1])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(v[2].v), _mm256_set1_pd(right[2])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(v[3].v), _mm256_set1_pd(right[3])));
+    
+    Vec<double,4> result;
+    _mm256_storeu_pd(result.v, r);
+    return result;
+}
+
+template <>
+inline const Vec<double,3> Mat<double,4,4>::operator*(const Vec<double,3>& right) const {
+    __m256d r = _mm256_mul_pd(_mm256_loadu_pd(v[0].v), _mm256_set1_pd(right[0]));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(v[1].v), _mm256_set1_pd(right[1])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(v[2].v), _mm256_set1_pd(right[2])));
+    r = _mm256_add_pd(r, _mm256_loadu_pd(v[3].v));
+    
+    double buffer[4];
+    _mm256_storeu_pd(buffer, r);
+    return Vec<double,3>(buffer[0] / buffer[3], buffer[1] / buffer[3], buffer[2] / buffer[3]);
+}
+#else
+template <>
+inline const Mat<double,4,4> Mat<double,4,4>::operator*(const Mat<double,4,4>& right) const {
+    // every column is split into the rows 0 and 1 (lo) and the rows 2 and 3 (hi)
+    const __m128d c0l = _mm_loadu_pd(v[0].v), c0h = _mm_loadu_pd(v[0].v + 2);
+    const __m128d c1l = _mm_loadu_pd(v[1].v), c1h = _mm_loadu_pd(v[1].v + 2);
+    const __m128d c2l = _mm_loadu_pd(v[2].v), c2h = _mm_loadu_pd(v[2].v + 2);
+    const __m128d c3l = _mm_loadu_pd(v[3].v), c3h = _mm_loadu_pd(v[3].v + 2);
+    
+    Mat<double,4,4> result;
+    for (size_t c = 0; c < 4; ++c) {
+        const __m128d f0 = _mm_set1_pd(right[c][0]);
+        const __m128d f1 = _mm_set1_pd(right[c][1]);
+        const __m128d f2 = _mm_set1_pd(right[c][2]);
+        const __m128d f3 = _mm_set1_pd(right[c][3]);
+        
+        __m128d rl = _mm_mul_pd(c0l, f0);
+        __m128d rh = _mm_mul_pd(c0h, f0);
+        rl = _mm_add_pd(rl, _mm_mul_pd(c1l, f1));
+        rh = _mm_add_pd(rh, _mm_mul_pd(c1h, f1));
+        rl = _mm_add_pd(rl, _mm_mul_pd(c2l, f2));
+        rh = _mm_add_pd(rh, _mm_mul_pd(c2h, f2));
+        rl = _mm_add_pd(rl, _mm_mul_pd(c3l, f3));
+        rh = _mm_add_pd(rh, _mm_mul_pd(c3h, f3));
+        _mm_storeu_pd(result[c].v, rl);
+        _mm_storeu_pd(result[c].v + 2, rh);
+    }
+    return result;
+}
+
+template <>
+inline const Vec<double,4> Mat<double,4,4>::operator*(const Vec<double,4>& right) const {
+    const __m128d f0 = _mm_set1_pd(right[0]);
+    const __m128d f1 = _mm_set1_pd(right[1]);
+    const __m128d f2 = _mm_set1_pd(right[2]);
+    const __m128d f3 = _mm_set1_pd(right[3]);
+    
+    __m128d rl = _mm_mul_pd(_mm_loadu_pd(v[0].v), f0);
+    __m128d rh = _mm_mul_pd(_mm_loadu_pd(v[0].v + 2), f0);
+    rl = _mm_add_pd(rl, _mm_mul_pd(_mm_loadu_pd(v[1].v), f1));
+    rh = _mm_add_pd(rh, _mm_mul_pd(_mm_loadu_pd(v[1].v + 2), f1));
+    rl = _mm_add_pd(rl, _mm_mul_pd(_mm_loadu_pd(v[2].v), f2));
+    rh = _mm_add_pd(rh, _mm_mul_pd(_mm_loadu_pd(v[2].v + 2), f2));
+    rl = _mm_add_pd(rl, _mm_mul_pd(_mm_loadu_pd(v[3].v), f3));
+    rh = _mm_add_pd(rh, _mm_mul_pd(_mm_loadu_pd(v[3].v + 2), f3));
+    
+    Vec<double,4> result;
+    _mm_storeu_pd(result.v, rl);
+    _mm_storeu_pd(result.v + 2, rh);
+    return result;
+}
+
+template <>
+inline const Vec<double,3> Mat<double,4,4>::operator*(const Vec<double,3>& right) const {
+    const __m128d f0 = _mm_set1_pd(right[0]);
+    const __m128d f1 = _mm_set1_pd(right[1]);
+    const __m128d f2 = _mm_set1_pd(right[2]);
+    
+    __m128d rl = _mm_mul_pd(_mm_loadu_pd(v[0].v), f0);
+    __m128d rh = _mm_mul_pd(_mm_loadu_pd(v[0].v + 2), f0);
+    rl = _mm_add_pd(rl, _mm_mul_pd(_mm_loadu_pd(v[1].v), f1));
+    rh = _mm_add_pd(rh, _mm_mul_pd(_mm_loadu_pd(v[1].v + 2), f1));
+    rl = _mm_add_pd(rl, _mm_mul_pd(_mm_loadu_pd(v[2].v), f2));
+    rh = _mm_add_pd(rh, _mm_mul_pd(_mm_loadu_pd(v[2].v + 2), f2));
+    rl = _mm_add_pd(rl, _mm_loadu_pd(v[3].v));
+    rh = _mm_add_pd(rh, _mm_loadu_pd(v[3].v + 2));
+    
+    const __m128d w = _mm_unpackhi_pd(rh, rh);
+    rl = _mm_div_pd(rl, w);
+    rh = _mm_div_pd(rh, w);
+    
+    Vec<double,3> result;
+    _mm_storeu_pd(result.v, rl);
+    _mm_store_sd(result.v + 2, rh);
+    return result;
+}
+#endif
+#endif
+
 template <typename T, size_t R, size_t C>
 Mat<T,R,C> operator*(const T left, const Mat<T,R,C>& right) {
     return right * left;
@@ -619,6 +789,17 @@ Mat<T,S,S> translationMatrix(const Mat<T,S,S>& mat) {
     return result;
 }
 
+template <typename T, size_t S>
+bool isTranslationMatrix(const Mat<T,S,S>& mat) {
+    for (size_t c = 0; c < S-1; ++c) {
+        for (size_t r = 0; r < S; ++r) {
+            if (mat[c][r] != (r == c ? static_cast<T>(1.0) : static_cast<T>(0.0)))
+                return false;
+        }
+    }
+    return mat[S-1][S-1] == static_cast<T>(1.0);
+}
+
 template <typename T, size_t S>
 Mat<T,S,S> stripTranslation(const Mat<T,S,S>& mat) {
     Mat<T,S,S> result(mat);
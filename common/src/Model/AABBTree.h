@@ -0,0 +1,580 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AABBTree
+#define TrenchBroom_AABBTree
+
+#include "BatchMath.h"
+#include "Exceptions.h"
+#include "VecMath.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         A bounding volume hierarchy of axis aligned bounding boxes. Every leaf holds one object, and every inner node
+         has exactly two children whose bounds are stored next to each other, so that a ray can be tested against both
+         children at once.
+
+         Objects are inserted next to the node that increases the surface area of the tree the least, and when the
+         number of objects has doubled since the last build, the tree is rebuilt from scratch using the binned surface
+         area heuristic. Updating the bounds of an object that stays within the bounds of its parent node only refits
+         the bounds of its ancestors.
+
+         The leaves can be enlarged by a margin so that objects which move or grow a little, e.g. while they are being
+         dragged, do not change the tree at all. In that case, the queries return every object whose enlarged bounds
+         match, and the caller must test the objects themselves.
+         */
+        template <typename F, typename T>
+        class AABBTree {
+        public:
+            typedef BBox<F,3> Box;
+            typedef std::vector<T> List;
+        private:
+            static const size_t Invalid;
+            static const size_t MinBuildSize = 64;
+            static const size_t BinCount = 16;
+
+            struct Node {
+                size_t parent;
+                size_t children; // the index of the first child, Invalid for leaves
+                T object;
+
+                Node() :
+                parent(Invalid),
+                children(Invalid),
+                object() {}
+            };
+
+            struct BuildItem {
+                Box bounds;
+                Vec<F,3> center;
+                T object;
+            };
+
+            struct BuildTask {
+                size_t index;
+                size_t parent;
+                size_t begin;
+                size_t end;
+            };
+
+            typedef std::unordered_map<T, size_t> LeafMap;
+            typedef std::pair<size_t, F> StackEntry;
+
+            // The root is stored at index 0, and the children of inner nodes are stored in pairs starting at odd
+            // indices. The bounds are kept in a separate vector so that the bounds of two siblings are contiguous.
+            std::vector<Node> m_nodes;
+            std::vector<Box> m_bounds;
+            std::vector<size_t> m_freePairs;
+            LeafMap m_leaves;
+            size_t m_buildSize;
+            F m_margin;
+        public:
+            explicit AABBTree(const F margin = F()) :
+            m_buildSize(0),
+            m_margin(margin) {
+                assert(m_margin >= F());
+            }
+
+            bool empty() const {
+                return m_leaves.empty();
+            }
+
+            size_t size() const {
+                return m_leaves.size();
+            }
+
+            /**
+             Returns the bounds of all objects in this tree, including the margin. The tree must not be empty.
+             */
+            const Box& bounds() const {
+                assert(!empty());
+                return m_bounds[0];
+            }
+
+            /**
+             Returns the depth of the deepest leaf, where the depth of the root is 1.
+             */
+            size_t depth() const {
+                return empty() ? 0 : depth(0);
+            }
+
+            void clear() {
+                m_nodes.clear();
+                m_bounds.clear();
+                m_freePairs.clear();
+                m_leaves.clear();
+                m_buildSize = 0;
+            }
+
+            void addObject(const Box& bounds, T object) {
+                if (m_leaves.count(object) > 0)
+                    throw AABBTreeException("Object is already contained in this tree");
+
+                const Box leafBounds = bounds.expanded(m_margin);
+                if (empty()) {
+                    m_nodes.assign(1, Node());
+                    m_bounds.assign(1, leafBounds);
+                    m_nodes[0].object = object;
+                    m_leaves.insert(std::make_pair(object, 0));
+                } else {
+                    insertLeaf(leafBounds, object);
+                    if (size() >= 2 * std::max(m_buildSize, MinBuildSize))
+                        rebuild();
+                }
+            }
+
+            void removeObject(T object) {
+                typename LeafMap::iterator it = m_leaves.find(object);
+                if (it == std::end(m_leaves))
+                    throw AABBTreeException("Cannot find object in tree");
+
+                const size_t index = it->second;
+                m_leaves.erase(it);
+
+                if (index == 0) {
+                    clear();
+                    return;
+                }
+
+                // replace the parent by the sibling of the removed leaf
+                const size_t parent = m_nodes[index].parent;
+                const size_t grandParent = m_nodes[parent].parent;
+                moveNode(sibling(index), parent);
+                m_nodes[parent].parent = grandParent;
+                m_freePairs.push_back(firstOfPair(index));
+
+                refit(grandParent);
+            }
+
+            void updateObject(const Box& bounds, T object) {
+                typename LeafMap::iterator it = m_leaves.find(object);
+                if (it == std::end(m_leaves))
+                    throw AABBTreeException("Cannot find object in tree");
+
+                // keep the leaf as long as it contains the new bounds and is not much larger than them
+                const size_t index = it->second;
+                const Box& current = m_bounds[index];
+                if (current.contains(bounds) && bounds.expanded(static_cast<F>(2.0) * m_margin).contains(current))
+                    return;
+
+                const Box leafBounds = bounds.expanded(m_margin);
+                const size_t parent = m_nodes[index].parent;
+                if (parent == Invalid || m_bounds[parent].contains(leafBounds)) {
+                    m_bounds[index] = leafBounds;
+                    refit(parent);
+                } else {
+                    removeObject(object);
+                    addObject(bounds, object);
+                }
+            }
+
+            bool containsObject(T object) const {
+                return m_leaves.count(object) > 0;
+            }
+
+            /**
+             Rebuilds this tree from scratch using the binned surface area heuristic.
+             */
+            void rebuild() {
+                std::vector<BuildItem> items;
+                items.reserve(size());
+
+                // collect the leaves by walking the tree, the order of the leaf map depends on the object values
+                std::vector<size_t> stack;
+                if (!empty())
+                    stack.push_back(0);
+                while (!stack.empty()) {
+                    const size_t index = stack.back();
+                    stack.pop_back();
+
+                    const Node& node = m_nodes[index];
+                    if (node.children == Invalid) {
+                        const Box& bounds = m_bounds[index];
+                        items.push_back(BuildItem { bounds, bounds.center(), node.object });
+                    } else {
+                        stack.push_back(node.children + 1);
+                        stack.push_back(node.children);
+                    }
+                }
+
+                clear();
+                if (!items.empty())
+                    build(items);
+            }
+
+            /**
+             Calls the given visitor for the objects whose bounds are hit by the given ray, roughly in front to back
+             order. The visitor returns the distance up to which it is interested in further objects, and objects
+             whose bounds are only hit beyond the smallest returned distance are skipped. A visitor that wants to see
+             every hit object returns infinity.
+             */
+            template <typename V>
+            void findObjects(const Ray<F,3>& ray, V visitor) const {
+                if (empty())
+                    return;
+
+                F distances[2];
+                BatchMath::intersectBoundsWithRay(ray, &m_bounds[0], 1, distances);
+                if (Math::isnan(distances[0]))
+                    return;
+
+                F maxDistance = std::numeric_limits<F>::infinity();
+                std::vector<StackEntry> stack;
+                stack.push_back(StackEntry(0, entryDistance(ray, 0, distances[0])));
+
+                while (!stack.empty()) {
+                    const StackEntry entry = stack.back();
+                    stack.pop_back();
+                    if (entry.second > maxDistance)
+                        continue;
+
+                    const Node& node = m_nodes[entry.first];
+                    if (node.children == Invalid) {
+                        maxDistance = std::min(maxDistance, visitor(node.object));
+                        continue;
+                    }
+
+                    const size_t first = node.children;
+                    BatchMath::intersectBoundsWithRay(ray, &m_bounds[first], 2, distances);
+
+                    // push the farther child first so that the nearer one is visited first
+                    const bool hit0 = !Math::isnan(distances[0]);
+                    const bool hit1 = !Math::isnan(distances[1]);
+                    const F distance0 = hit0 ? entryDistance(ray, first, distances[0]) : F();
+                    const F distance1 = hit1 ? entryDistance(ray, first + 1, distances[1]) : F();
+                    if (hit0 && hit1) {
+                        if (distance0 < distance1) {
+                            stack.push_back(StackEntry(first + 1, distance1));
+                            stack.push_back(StackEntry(first, distance0));
+                        } else {
+                            stack.push_back(StackEntry(first, distance0));
+                            stack.push_back(StackEntry(first + 1, distance1));
+                        }
+                    } else if (hit0) {
+                        stack.push_back(StackEntry(first, distance0));
+                    } else if (hit1) {
+                        stack.push_back(StackEntry(first + 1, distance1));
+                    }
+                }
+            }
+
+            List findObjects(const Ray<F,3>& ray) const {
+                List result;
+                findObjects(ray, [&result](T object) {
+                    result.push_back(object);
+                    return std::numeric_limits<F>::infinity();
+                });
+                return result;
+            }
+
+            /**
+             Returns the objects whose bounds intersect the given bounds. Bounds that only touch count as
+             intersecting.
+             */
+            List findIntersectingObjects(const Box& bounds) const {
+                List result;
+                if (empty() || !m_bounds[0].intersects(bounds))
+                    return result;
+
+                bool hits[2];
+                std::vector<size_t> stack(1, 0);
+                while (!stack.empty()) {
+                    const size_t index = stack.back();
+                    stack.pop_back();
+
+                    const Node& node = m_nodes[index];
+                    if (node.children == Invalid) {
+                        result.push_back(node.object);
+                    } else {
+                        BatchMath::intersectsBounds(bounds, &m_bounds[node.children], 2, hits);
+                        if (hits[0])
+                            stack.push_back(node.children);
+                        if (hits[1])
+                            stack.push_back(node.children + 1);
+                    }
+                }
+                return result;
+            }
+
+            List findObjects(const Vec<F,3>& point) const {
+                List result;
+                if (empty())
+                    return result;
+
+                std::vector<size_t> stack(1, 0);
+                while (!stack.empty()) {
+                    const size_t index = stack.back();
+                    stack.pop_back();
+                    if (!m_bounds[index].contains(point))
+                        continue;
+
+                    const Node& node = m_nodes[index];
+                    if (node.children == Invalid) {
+                        result.push_back(node.object);
+                    } else {
+                        stack.push_back(node.children);
+                        stack.push_back(node.children + 1);
+                    }
+                }
+                return result;
+            }
+        private:
+            static size_t firstOfPair(const size_t index) {
+                assert(index > 0);
+                return index % 2 == 1 ? index : index - 1;
+            }
+
+            static size_t sibling(const size_t index) {
+                assert(index > 0);
+                return index % 2 == 1 ? index + 1 : index - 1;
+            }
+
+            static F surfaceArea(const Box& bounds) {
+                const Vec<F,3> size = bounds.size();
+                return static_cast<F>(2.0) * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+            }
+
+            F entryDistance(const Ray<F,3>& ray, const size_t index, const F distance) const {
+                // the slab test returns the exit distance if the ray starts inside of a box
+                return m_bounds[index].contains(ray.origin) ? static_cast<F>(0.0) : distance;
+            }
+
+            size_t depth(const size_t index) const {
+                const Node& node = m_nodes[index];
+                if (node.children == Invalid)
+                    return 1;
+                return 1 + std::max(depth(node.children), depth(node.children + 1));
+            }
+
+            size_t allocatePair() {
+                if (!m_freePairs.empty()) {
+                    const size_t first = m_freePairs.back();
+                    m_freePairs.pop_back();
+                    return first;
+                }
+
+                const size_t first = m_nodes.size();
+                m_nodes.resize(first + 2);
+                m_bounds.resize(first + 2);
+                return first;
+            }
+
+            void moveNode(const size_t from, const size_t to) {
+                m_nodes[to] = m_nodes[from];
+                m_bounds[to] = m_bounds[from];
+
+                const Node& node = m_nodes[to];
+                if (node.children == Invalid) {
+                    m_leaves[node.object] = to;
+                } else {
+                    m_nodes[node.children].parent = to;
+                    m_nodes[node.children + 1].parent = to;
+                }
+            }
+
+            void refit(size_t index) {
+                while (index != Invalid) {
+                    const size_t first = m_nodes[index].children;
+                    const Box bounds = m_bounds[first].mergedWith(m_bounds[first + 1]);
+                    if (bounds == m_bounds[index])
+                        return;
+                    m_bounds[index] = bounds;
+                    index = m_nodes[index].parent;
+                }
+            }
+
+            void insertLeaf(const Box& bounds, T object) {
+                const size_t target = findSibling(bounds);
+
+                // move the sibling into a new pair of nodes and turn its old node into their parent
+                const size_t first = allocatePair();
+                moveNode(target, first);
+                m_nodes[first].parent = target;
+
+                Node& leaf = m_nodes[first + 1];
+                leaf.parent = target;
+                leaf.children = Invalid;
+                leaf.object = object;
+                m_bounds[first + 1] = bounds;
+                m_leaves.insert(std::make_pair(object, first + 1));
+
+                m_nodes[target].children = first;
+                m_bounds[target] = m_bounds[first].mergedWith(bounds);
+                refit(m_nodes[target].parent);
+            }
+
+            size_t findSibling(const Box& bounds) const {
+                size_t index = 0;
+                while (m_nodes[index].children != Invalid) {
+                    const size_t first = m_nodes[index].children;
+
+                    // creating a new parent for this node and the new leaf
+                    const F area = surfaceArea(m_bounds[index]);
+                    const F combinedArea = surfaceArea(m_bounds[index].mergedWith(bounds));
+                    const F cost = static_cast<F>(2.0) * combinedArea;
+
+                    // the minimum cost of pushing the new leaf further down the tree
+                    const F inheritanceCost = static_cast<F>(2.0) * (combinedArea - area);
+                    const F cost0 = descendCost(first, bounds) + inheritanceCost;
+                    const F cost1 = descendCost(first + 1, bounds) + inheritanceCost;
+
+                    if (cost < cost0 && cost < cost1)
+                        break;
+                    index = cost0 <= cost1 ? first : first + 1;
+                }
+                return index;
+            }
+
+            F descendCost(const size_t index, const Box& bounds) const {
+                const F combinedArea = surfaceArea(m_bounds[index].mergedWith(bounds));
+                if (m_nodes[index].children == Invalid)
+                    return combinedArea;
+                return combinedArea - surfaceArea(m_bounds[index]);
+            }
+
+            void build(std::vector<BuildItem>& items) {
+                m_nodes.assign(1, Node());
+                m_bounds.assign(1, Box());
+                m_leaves.reserve(items.size());
+
+                std::vector<BuildTask> tasks;
+                tasks.push_back(BuildTask { 0, Invalid, 0, items.size() });
+
+                while (!tasks.empty()) {
+                    const BuildTask task = tasks.back();
+                    tasks.pop_back();
+
+                    m_nodes[task.index].parent = task.parent;
+                    if (task.end - task.begin == 1) {
+                        const BuildItem& item = items[task.begin];
+                        m_nodes[task.index].object = item.object;
+                        m_bounds[task.index] = item.bounds;
+                        m_leaves.insert(std::make_pair(item.object, task.index));
+                    } else {
+                        const size_t mid = partition(items, task.begin, task.end);
+                        const size_t first = allocatePair();
+                        m_nodes[task.index].children = first;
+                        tasks.push_back(BuildTask { first, task.index, task.begin, mid });
+                        tasks.push_back(BuildTask { first + 1, task.index, mid, task.end });
+                    }
+                }
+
+                // children are always stored after their parents
+                for (size_t i = m_nodes.size(); i > 0; --i) {
+                    const size_t index = i - 1;
+                    const size_t first = m_nodes[index].children;
+                    if (first != Invalid)
+                        m_bounds[index] = m_bounds[first].mergedWith(m_bounds[first + 1]);
+                }
+
+                m_buildSize = items.size();
+            }
+
+            size_t partition(std::vector<BuildItem>& items, const size_t begin, const size_t end) const {
+                typedef typename std::vector<BuildItem>::iterator Iter;
+                const Iter first = std::begin(items) + static_cast<std::ptrdiff_t>(begin);
+                const Iter last = std::begin(items) + static_cast<std::ptrdiff_t>(end);
+
+                Box centers(first->center, first->center);
+                for (Iter it = first; it != last; ++it)
+                    centers.mergeWith(it->center);
+
+                const Vec<F,3> extents = centers.size();
+                const size_t axis = extents.firstComponent();
+                const F extent = extents[axis];
+
+                const size_t mid = begin + (end - begin) / 2;
+                if (extent <= static_cast<F>(0.0))
+                    return mid;
+
+                const F scale = static_cast<F>(BinCount) / extent;
+                const auto binIndex = [&](const BuildItem& item) {
+                    const size_t bin = static_cast<size_t>((item.center[axis] - centers.min[axis]) * scale);
+                    return std::min(bin, BinCount - 1);
+                };
+
+                size_t counts[BinCount] = {};
+                Box bins[BinCount];
+                for (Iter it = first; it != last; ++it) {
+                    const size_t bin = binIndex(*it);
+                    bins[bin] = counts[bin] == 0 ? it->bounds : bins[bin].mergedWith(it->bounds);
+                    ++counts[bin];
+                }
+
+                // the cost of splitting after bin i is the number of items on each side times the area of its bounds
+                F rightCosts[BinCount];
+                size_t rightCount = 0;
+                Box rightBounds;
+                for (size_t i = BinCount - 1; i > 0; --i) {
+                    if (counts[i] > 0) {
+                        rightBounds = rightCount == 0 ? bins[i] : rightBounds.mergedWith(bins[i]);
+                        rightCount += counts[i];
+                    }
+                    rightCosts[i - 1] = static_cast<F>(rightCount) * surfaceArea(rightBounds);
+                }
+
+                F bestCost = std::numeric_limits<F>::infinity();
+                size_t bestSplit = BinCount;
+                size_t leftCount = 0;
+                Box leftBounds;
+                for (size_t i = 0; i < BinCount - 1; ++i) {
+                    if (counts[i] > 0) {
+                        leftBounds = leftCount == 0 ? bins[i] : leftBounds.mergedWith(bins[i]);
+                        leftCount += counts[i];
+                    }
+                    if (leftCount > 0 && leftCount < end - begin) {
+                        const F cost = static_cast<F>(leftCount) * surfaceArea(leftBounds) + rightCosts[i];
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestSplit = i;
+                        }
+                    }
+                }
+
+                if (bestSplit == BinCount) {
+                    std::nth_element(first, std::begin(items) + static_cast<std::ptrdiff_t>(mid), last, [axis](const BuildItem& lhs, const BuildItem& rhs) {
+                        return lhs.center[axis] < rhs.center[axis];
+                    });
+                    return mid;
+                }
+
+                const Iter split = std::partition(first, last, [&](const BuildItem& item) { return binIndex(item) <= bestSplit; });
+                return static_cast<size_t>(split - std::begin(items));
+            }
+        };
+
+        template <typename F, typename T>
+        const size_t AABBTree<F,T>::Invalid = std::numeric_limits<size_t>::max();
+
+        template <typename F, typename T>
+        const size_t AABBTree<F,T>::MinBuildSize;
+
+        template <typename F, typename T>
+        const size_t AABBTree<F,T>::BinCount;
+    }
+}
+
+#endif /* defined(TrenchBroom_AABBTree) */
@@ -19,7 +19,7 @@
 
 #include "AttributableNodeIndex.h"
 
-#include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "Macros.h"
 #include "Model/AttributableNode.h"
 
@@ -43,20 +43,6 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
         
-        AttributableNodeSet AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
-            switch (m_type) {
-                case Type_Exact:
-                    return index.queryExactMatches(m_pattern);
-                case Type_Prefix:
-                    return index.queryPrefixMatches(m_pattern);
-                case Type_Numbered:
-                    return index.queryNumberedMatches(m_pattern);
-                case Type_Any:
-                    return EmptyAttributableNodeSet;
-                switchDefault()
-            }
-        }
-        
         bool AttributableNodeIndexQuery::execute(const AttributableNode* node, const String& value) const {
             switch (m_type) {
                 case Type_Exact:
@@ -86,34 +72,38 @@ namespace TrenchBroom {
         }
 
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.insert(name, attributable);
-            m_valueIndex.insert(value, attributable);
+            NodeCounts& nodes = m_valueIndex[value];
+            ++nodes[attributable];
         }
         
         void AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.remove(name, attributable);
-            m_valueIndex.remove(value, attributable);
+            ValueIndex::iterator valueIt = m_valueIndex.find(value);
+            if (valueIt == std::end(m_valueIndex))
+                throw Exception("Cannot remove attribute value from index");
+            
+            NodeCounts& nodes = valueIt->second;
+            NodeCounts::iterator nodeIt = nodes.find(attributable);
+            if (nodeIt == std::end(nodes))
+                throw Exception("Cannot remove attribute value from index");
+            
+            if (--nodeIt->second == 0) {
+                nodes.erase(nodeIt);
+                if (nodes.empty())
+                    m_valueIndex.erase(valueIt);
+            }
         }
 
         AttributableNodeList AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const AttributeValue& value) const {
-            const AttributableNodeSet nameResult = nameQuery.execute(m_nameIndex);
-            const AttributableNodeSet valueResult = m_valueIndex.queryExactMatches(value);
-            
-            if (nameResult.empty() || valueResult.empty())
+            const ValueIndex::const_iterator it = m_valueIndex.find(value);
+            if (it == std::end(m_valueIndex))
                 return EmptyAttributableNodeList;
-
-            AttributableNodeList result;
-            SetUtils::intersection(nameResult, valueResult, result);
             
-            AttributableNodeList::iterator it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
+            AttributableNodeList result;
+            for (const NodeCounts::value_type& entry : it->second) {
+                AttributableNode* node = entry.first;
+                if (nameQuery.execute(node, value))
+                    result.push_back(node);
             }
-            
             return result;
         }
     }
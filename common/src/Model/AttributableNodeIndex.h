@@ -22,15 +22,12 @@
 
 #include "StringUtils.h"
 #include "Model/ModelTypes.h"
-#include "StringMap.h"
 
 #include <map>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Model {
-        typedef StringMultiMapValueContainer<AttributableNode*> AttributableNodeIndexValueContainer;
-        typedef StringMap<AttributableNode*, AttributableNodeIndexValueContainer> AttributableNodeStringIndex;
-        
         class AttributableNodeIndexQuery {
         public:
             typedef enum {
@@ -48,16 +45,21 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const String& pattern);
             static AttributableNodeIndexQuery any();
 
-            AttributableNodeSet execute(const AttributableNodeStringIndex& index) const;
             bool execute(const AttributableNode* node, const String& value) const;
         private:
             AttributableNodeIndexQuery(Type type, const String& pattern = "");
         };
         
+        /**
+         Maps attribute values to the nodes that have them. Since every query asks for an exact value, the nodes having
+         that value are looked up by hashing, and only they are matched against the name query.
+         */
         class AttributableNodeIndex {
         private:
-            AttributableNodeStringIndex m_nameIndex;
-            AttributableNodeStringIndex m_valueIndex;
+            // counts how many attributes of each node have the value
+            typedef std::map<AttributableNode*, size_t> NodeCounts;
+            typedef std::unordered_map<AttributeValue, NodeCounts> ValueIndex;
+            ValueIndex m_valueIndex;
         public:
             void addAttributableNode(AttributableNode* attributable);
             void removeAttributableNode(AttributableNode* attributable);
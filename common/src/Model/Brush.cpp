@@ -20,6 +20,7 @@
 #include "Brush.h"
 
 #include "CollectionUtils.h"
+#include "ParallelUtils.h"
 #include "Model/BrushContentTypeBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -380,13 +381,22 @@ namespace TrenchBroom {
             }
         }
 
+        Brush::Brush(const BrushFaceList& faces, BrushGeometryPtr geometry) :
+        m_geometry(geometry),
+        m_contentTypeBuilder(NULL),
+        m_contentType(0),
+        m_transparent(false),
+        m_contentTypeValid(true) {
+            ensure(m_geometry != NULL, "geometry is null");
+            addFaces(faces);
+        }
+
         Brush::~Brush() {
             cleanup();
         }
 
         void Brush::cleanup() {
-            delete m_geometry;
-            m_geometry = NULL;
+            m_geometry.reset();
             VectorUtils::clearAndDelete(m_faces);
             m_contentTypeBuilder = NULL;
         }
@@ -467,6 +477,20 @@ namespace TrenchBroom {
             rebuildGeometry(worldBounds);
         }
 
+        void Brush::restoreFaces(const BrushFaceList& faces, BrushGeometryPtr geometry) {
+            ensure(geometry != NULL, "geometry is null");
+            
+            // The given faces were cloned from the payloads of the given geometry, so the geometry can be reused
+            // instead of clipping a new one.
+            const NotifyNodeChange nodeChange(this);
+            detachFaces(m_faces);
+            VectorUtils::clearAndDelete(m_faces);
+            m_geometry = geometry;
+            linkFaces(*m_geometry, faces);
+            addFaces(faces);
+            nodeBoundsDidChange();
+        }
+
         bool Brush::fullySpecified() const {
             ensure(m_geometry != NULL, "geometry is null");
             
@@ -589,7 +613,7 @@ namespace TrenchBroom {
                 }
             }
             
-            restoreFaceLinks(m_geometry);
+            restoreFaceLinks(*m_geometry);
             delete testFace;
             
             return (fullySpecified &&
@@ -715,16 +739,19 @@ namespace TrenchBroom {
             ensure(!vertexPositions.empty(), "no vertex positions");
             assert(canMoveVertices(worldBounds, vertexPositions, delta));
 
-            BrushGeometry newGeometry;
             Vec3::Set vertexSet(std::begin(vertexPositions), std::end(vertexPositions));
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
             
             for (BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) > 0)
-                    newGeometry.addPoint(position + delta);
+                    newPositions.push_back(position + delta);
                 else
-                    newGeometry.addPoint(position);
+                    newPositions.push_back(position);
             }
+            
+            BrushGeometry newGeometry(newPositions);
 
             Vec3::List result;
             Vec3::Map vertexMapping;
@@ -786,29 +813,34 @@ namespace TrenchBroom {
             ensure(!vertexPositions.empty(), "no vertex positions");
             assert(canRemoveVertices(worldBounds, vertexPositions));
             
-            BrushGeometry newGeometry;
             const Vec3::Set vertexSet(std::begin(vertexPositions), std::end(vertexPositions));
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
             
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) == 0)
-                    newGeometry.addPoint(position);
+                    newPositions.push_back(position);
             }
             
+            BrushGeometry newGeometry(newPositions);
+            
             const PolyhedronMatcher<BrushGeometry> matcher(*m_geometry, newGeometry);
             doSetNewGeometry(worldBounds, matcher, newGeometry);
         }
 
         bool Brush::canSnapVertices(const BBox3& worldBounds, const size_t snapTo) {
             const FloatType snapToF = static_cast<FloatType>(snapTo);
-            BrushGeometry newGeometry;
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
             
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
-                const Vec3 destination = snapToF * (origin / snapToF).rounded();
-                newGeometry.addPoint(destination);
+                newPositions.push_back(snapToF * (origin / snapToF).rounded());
             }
             
+            BrushGeometry newGeometry(newPositions);
+            
             return newGeometry.polyhedron();
         }
 
@@ -816,13 +848,15 @@ namespace TrenchBroom {
             ensure(m_geometry != NULL, "geometry is null");
 
             const FloatType snapToF = static_cast<FloatType>(snapTo);
-            BrushGeometry newGeometry;
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
             
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
-                const Vec3 destination = snapToF * (origin / snapToF).rounded();
-                newGeometry.addPoint(destination);
+                newPositions.push_back(snapToF * (origin / snapToF).rounded());
             }
+            
+            BrushGeometry newGeometry(newPositions);
 
             Vec3::Map vertexMapping;
             for (const BrushVertex* vertex : m_geometry->vertices()) {
@@ -977,17 +1011,20 @@ namespace TrenchBroom {
             }
             
             BrushGeometry moving(*m_geometry);
-            BrushGeometry result;
+            Vec3::List resultPositions;
+            resultPositions.reserve(m_geometry->vertexCount());
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) == 0) {
                     moving.removeVertexByPosition(position);
-                    result.addPoint(position);
+                    resultPositions.push_back(position);
                 } else {
-                    result.addPoint(position + delta);
+                    resultPositions.push_back(position + delta);
                 }
             }
             
+            BrushGeometry result(resultPositions);
+            
             assert(remaining.vertexCount() + moving.vertexCount() == vertexCount());
             
             // Will the result go out of world bounds?
@@ -1046,7 +1083,11 @@ namespace TrenchBroom {
             matcher.processRightFaces(FaceMatchingCallback());
             
             const NotifyNodeChange nodeChange(this);
-            using std::swap; swap(*m_geometry, newGeometry);
+            
+            // The current geometry may be shared with a snapshot, so the new geometry is moved into a new object.
+            BrushGeometryPtr geometry(new BrushGeometry());
+            using std::swap; swap(*geometry, newGeometry);
+            m_geometry = geometry;
             VectorUtils::clearAndDelete(m_faces);
             updateFacesFromGeometry(worldBounds);
             assert(fullySpecified());
@@ -1123,8 +1164,12 @@ namespace TrenchBroom {
         }
 
         void Brush::rebuildGeometry(const BBox3& worldBounds) {
-            delete m_geometry;
-            m_geometry = new BrushGeometry(worldBounds.expanded(1.0));
+            buildGeometry(worldBounds);
+            nodeBoundsDidChange();
+        }
+
+        void Brush::buildGeometry(const BBox3& worldBounds) {
+            m_geometry = BrushGeometryPtr(new BrushGeometry(worldBounds.expanded(1.0)));
             
             AddFacesToGeometry addFacesToGeometry(*m_geometry, m_faces);
             updateFacesFromGeometry(worldBounds);
@@ -1134,7 +1179,6 @@ namespace TrenchBroom {
                 throw GeometryException("Brush is invalid");
             if (!fullySpecified())
                 throw GeometryException("Brush is not fully specified");
-            nodeBoundsDidChange();
         }
 
         void Brush::findIntegerPlanePoints(const BBox3& worldBounds) {
@@ -1145,6 +1189,108 @@ namespace TrenchBroom {
             rebuildGeometry(worldBounds);
         }
 
+        void Brush::findIntegerPlanePoints(const BrushList& brushes, const BBox3& worldBounds, const ProgressCallback& progress) {
+            static const size_t BlockSize = 4096;
+            
+            BrushFaceList faces;
+            std::vector<size_t> faceBrushIndices;
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                VectorUtils::append(faces, brushes[i]->faces());
+                faceBrushIndices.resize(faces.size(), i);
+            }
+            
+            const size_t total = faces.size() + brushes.size();
+            const auto reportProgress = [&](const size_t done) {
+                if (progress)
+                    progress(static_cast<double>(done) / static_cast<double>(total));
+            };
+            
+            for (Brush* brush : brushes)
+                brush->nodeWillChange();
+            
+            std::vector<std::exception_ptr> faceExceptions(faces.size());
+            ParallelUtils::parallelForBlocks(faces.size(), BlockSize, [&](const size_t i) {
+                try {
+                    faces[i]->findIntegerPlanePoints();
+                } catch (...) {
+                    faceExceptions[i] = std::current_exception();
+                }
+            }, reportProgress);
+            
+            std::vector<std::exception_ptr> exceptions(brushes.size());
+            for (size_t i = 0; i < faces.size(); ++i) {
+                if (faceExceptions[i] && !exceptions[faceBrushIndices[i]])
+                    exceptions[faceBrushIndices[i]] = faceExceptions[i];
+            }
+            
+            ParallelUtils::parallelForBlocks(brushes.size(), BlockSize, [&](const size_t i) {
+                if (exceptions[i])
+                    return;
+                try {
+                    brushes[i]->buildGeometry(worldBounds);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            }, [&](const size_t done) { reportProgress(faces.size() + done); });
+            
+            finishBatchChange(brushes, exceptions);
+        }
+
+        void Brush::transformBrushes(const BrushList& brushes, const Mat4x4& transformation, const bool lockTextures, const BBox3& worldBounds) {
+            for (Brush* brush : brushes)
+                brush->nodeWillChange();
+            
+            std::vector<std::exception_ptr> exceptions(brushes.size());
+            ParallelUtils::parallelFor(brushes.size(), [&](const size_t i) {
+                try {
+                    brushes[i]->transformFacesAndGeometry(transformation, lockTextures, worldBounds);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            });
+            
+            finishBatchChange(brushes, exceptions);
+        }
+        
+        void Brush::finishBatchChange(const BrushList& brushes, const std::vector<std::exception_ptr>& exceptions) {
+            std::exception_ptr exception;
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                Brush* brush = brushes[i];
+                if (!exceptions[i])
+                    brush->nodeBoundsDidChange();
+                else if (!exception)
+                    exception = exceptions[i];
+                brush->nodeDidChange();
+            }
+            
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+        
+        void Brush::transformFacesAndGeometry(const Mat4x4& transformation, const bool lockTextures, const BBox3& worldBounds) {
+            for (BrushFace* face : m_faces)
+                face->transform(transformation, lockTextures);
+            
+            // Moving a brush by an integer offset doesn't change its topology, so the existing geometry can be
+            // translated instead of clipping a new one from the transformed faces.
+            if (isTranslationMatrix(transformation)) {
+                const Vec3 delta = transformation[3].xyz();
+                if (delta.rounded() == delta && worldBounds.expanded(1.0).contains(bounds().translated(delta))) {
+                    detachGeometry();
+                    m_geometry->translate(delta);
+                    return;
+                }
+            }
+            
+            buildGeometry(worldBounds);
+        }
+
+        void Brush::detachGeometry() {
+            ensure(m_geometry != NULL, "geometry is null");
+            if (!m_geometry.unique())
+                m_geometry = copyGeometry(*m_geometry);
+        }
+
         bool Brush::checkGeometry() const {
             for (const BrushFace* face : m_faces) {
                 if (face->geometry() == NULL)
@@ -1213,13 +1359,20 @@ namespace TrenchBroom {
         }
 
         Node* Brush::doClone(const BBox3& worldBounds) const {
+            ensure(m_geometry != NULL, "geometry is null");
+            
+            // Copy the topology instead of clipping it again from the cloned faces. The faces of the clone must be
+            // in the same order as the faces of the geometry.
             BrushFaceList faceClones;
-            faceClones.reserve(m_faces.size());
+            faceClones.reserve(m_geometry->faceCount());
+            
+            for (const BrushFaceGeometry* geometry : m_geometry->faces())
+                faceClones.push_back(geometry->payload()->clone());
             
-            for (const BrushFace* face : m_faces)
-                faceClones.push_back(face->clone());
+            BrushGeometryPtr geometryClone(new BrushGeometry(*m_geometry));
+            linkFaces(*geometryClone, faceClones);
             
-            Brush* brush = new Brush(worldBounds, faceClones);
+            Brush* brush = new Brush(faceClones, geometryClone);
             brush->setContentTypeBuilder(m_contentTypeBuilder);
             cloneAttributes(brush);
             return brush;
@@ -1312,11 +1465,8 @@ namespace TrenchBroom {
         
         void Brush::doTransform(const Mat4x4& transformation, bool lockTextures, const BBox3& worldBounds) {
             const NotifyNodeChange nodeChange(this);
-
-            for (BrushFace* face : m_faces)
-                face->transform(transformation, lockTextures);
-
-            rebuildGeometry(worldBounds);
+            transformFacesAndGeometry(transformation, lockTextures, worldBounds);
+            nodeBoundsDidChange();
         }
         
         class Brush::Contains : public ConstNodeVisitor, public NodeQuery<bool> {
@@ -30,6 +30,10 @@
 #include "Model/Node.h"
 #include "Model/Object.h"
 
+#include <exception>
+#include <functional>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         struct BrushAlgorithmResult;
@@ -40,6 +44,7 @@ namespace TrenchBroom {
         class Brush : public Node, public Object {
         private:
             friend class SetTempFaceLinks;
+            friend class BrushSnapshot;
         public:
             static const Hit::HitType BrushHit;
         private:
@@ -61,11 +66,12 @@ namespace TrenchBroom {
             class QueryCallback;
             class FaceMatchingCallback;
         public:
+            typedef std::function<void(double)> ProgressCallback;
             typedef ConstProjectingSequence<BrushVertexList, ProjectToVertex> VertexList;
             typedef ConstProjectingSequence<BrushEdgeList, ProjectToEdge> EdgeList;
         private:
             BrushFaceList m_faces;
-            BrushGeometry* m_geometry;
+            BrushGeometryPtr m_geometry;
             
             const BrushContentTypeBuilder* m_contentTypeBuilder;
             mutable BrushContentType::FlagType m_contentType;
@@ -75,6 +81,7 @@ namespace TrenchBroom {
             Brush(const BBox3& worldBounds, const BrushFaceList& faces);
             ~Brush();
         private:
+            Brush(const BrushFaceList& faces, BrushGeometryPtr geometry);
             void cleanup();
         public:
             Brush* clone(const BBox3& worldBounds) const;
@@ -94,6 +101,7 @@ namespace TrenchBroom {
             
             void faceDidChange();
         private:
+            void restoreFaces(const BrushFaceList& faces, BrushGeometryPtr geometry);
             void addFaces(const BrushFaceList& faces);
             template <typename I>
             void addFaces(I cur, I end, size_t count) {
@@ -206,8 +214,27 @@ namespace TrenchBroom {
         public: // brush geometry
             void rebuildGeometry(const BBox3& worldBounds);
             void findIntegerPlanePoints(const BBox3& worldBounds);
+            
+            /**
+             Finds integer plane points for the faces of the given brushes and rebuilds their geometry, both on
+             multiple threads. The given callback is called on the calling thread with the fraction of work done so
+             far. Exceptions are handled like in transformBrushes.
+             */
+            static void findIntegerPlanePoints(const BrushList& brushes, const BBox3& worldBounds, const ProgressCallback& progress = ProgressCallback());
         private:
+            void buildGeometry(const BBox3& worldBounds);
+            void detachGeometry();
             bool checkGeometry() const;
+        public: // batch transformation
+            /**
+             Transforms the given brushes, computing their new faces and geometry on multiple threads. The node change
+             notifications are issued on the calling thread. If any brush cannot be transformed, the first exception
+             is rethrown after all other brushes have been processed.
+             */
+            static void transformBrushes(const BrushList& brushes, const Mat4x4& transformation, bool lockTextures, const BBox3& worldBounds);
+        private:
+            void transformFacesAndGeometry(const Mat4x4& transformation, bool lockTextures, const BBox3& worldBounds);
+            static void finishBatchChange(const BrushList& brushes, const std::vector<std::exception_ptr>& exceptions);
         public: // content type
             bool transparent() const;
             bool hasContentType(const BrushContentType& contentType) const;
@@ -302,7 +302,10 @@ namespace TrenchBroom {
 
         void BrushFace::updateTexture(Assets::TextureManager* textureManager) {
             ensure(textureManager != NULL, "textureManager is null");
-            Assets::Texture* texture = textureManager->texture(textureName());
+            updateTexture(textureManager->texture(textureName()));
+        }
+
+        void BrushFace::updateTexture(Assets::Texture* texture) {
             setTexture(texture);
             invalidateVertexCache();
         }
@@ -147,6 +147,7 @@ namespace TrenchBroom {
             bool hasSurfaceAttributes() const;
 
             void updateTexture(Assets::TextureManager* textureManager);
+            void updateTexture(Assets::Texture* texture);
             void setTexture(Assets::Texture* texture);
             void unsetTexture();
             
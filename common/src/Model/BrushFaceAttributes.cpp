@@ -18,13 +18,19 @@
  */
 
 #include "BrushFaceAttributes.h"
+#include "StringPool.h"
 #include "Assets/Texture.h"
 #include "Model/BrushFace.h"
 
 namespace TrenchBroom {
     namespace Model {
+        static const String* internTextureName(const String& textureName) {
+            static StringPool pool;
+            return &pool.intern(textureName);
+        }
+        
         BrushFaceAttributes::BrushFaceAttributes(const String& textureName) :
-        m_textureName(textureName),
+        m_textureName(internTextureName(textureName)),
         m_texture(NULL),
         m_offset(Vec2f::Null),
         m_scale(Vec2f(1.0f, 1.0f)),
@@ -70,7 +76,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
-            BrushFaceAttributes result(m_textureName);
+            BrushFaceAttributes result(*m_textureName);
             result.m_offset = m_offset;
             result.m_scale = m_scale;
             result.m_rotation = m_rotation;
@@ -81,7 +87,7 @@ namespace TrenchBroom {
         }
 
         const String& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return *m_textureName;
         }
         
         Assets::Texture* BrushFaceAttributes::texture() const {
@@ -146,7 +152,7 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != NULL) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                m_textureName = internTextureName(m_texture->name());
             }
         }
         
@@ -154,7 +160,7 @@ namespace TrenchBroom {
             if (m_texture != NULL)
                 m_texture->decUsageCount();
             m_texture = NULL;
-            m_textureName = BrushFace::NoTextureName;
+            m_textureName = internTextureName(BrushFace::NoTextureName);
         }
 
         void BrushFaceAttributes::setOffset(const Vec2f& offset) {
@@ -32,7 +32,8 @@ namespace TrenchBroom {
     namespace Model {
         class BrushFaceAttributes {
         private:
-            String m_textureName;
+            // texture names are interned, so faces with the same texture share their name
+            const String* m_textureName;
             Assets::Texture* m_texture;
             
             Vec2f m_offset;
@@ -51,6 +52,9 @@ namespace TrenchBroom {
             
             BrushFaceAttributes takeSnapshot() const;
             
+            /**
+             Returns the texture name. Attributes with equal texture names return references to the same string.
+             */
             const String& textureName() const;
             Assets::Texture* texture() const;
             Vec2f textureSize() const;
@@ -39,5 +39,12 @@ namespace TrenchBroom {
             if (m_coordSystemSnapshot != nullptr)
                 face->restoreTexCoordSystemSnapshot(m_coordSystemSnapshot);
         }
+
+        size_t BrushFaceSnapshot::memoryUsage() const {
+            size_t result = sizeof(BrushFaceSnapshot);
+            if (m_coordSystemSnapshot != nullptr)
+                result += sizeof(TexCoordSystemSnapshot);
+            return result;
+        }
     }
 }
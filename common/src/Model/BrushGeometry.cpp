@@ -38,6 +38,33 @@ namespace TrenchBroom {
                 current = current->next();
             } while (current != first);
         }
+        
+        void linkFaces(BrushGeometry& geometry, const std::vector<BrushFace*>& faces) {
+            ensure(geometry.faceCount() == faces.size(), "face count does not match");
+            
+            size_t index = 0;
+            for (BrushGeometry::Face* current : geometry.faces()) {
+                BrushFace* face = faces[index++];
+                current->setPayload(face);
+                face->setGeometry(current);
+            }
+        }
+        
+        BrushGeometryPtr copyGeometry(const BrushGeometry& geometry) {
+            // The copy constructor preserves the order of the faces, but not their payloads.
+            BrushGeometryPtr result(new BrushGeometry(geometry));
+            
+            BrushGeometry::Face* original = geometry.faces().front();
+            for (BrushGeometry::Face* copy : result->faces()) {
+                BrushFace* face = original->payload();
+                copy->setPayload(face);
+                if (face != NULL)
+                    face->setGeometry(copy);
+                original = original->next();
+            }
+            
+            return result;
+        }
 
         SetTempFaceLinks::SetTempFaceLinks(Brush* brush, BrushGeometry& tempGeometry) :
         m_brush(brush) {
@@ -46,7 +73,7 @@ namespace TrenchBroom {
         }
         
         SetTempFaceLinks::~SetTempFaceLinks() {
-            restoreFaceLinks(m_brush->m_geometry);
+            restoreFaceLinks(*m_brush->m_geometry);
             assert(m_brush->checkGeometry());
         }
     }
@@ -24,6 +24,9 @@
 #include "Polyhedron.h"
 #include "Polyhedron_BrushGeometryPayload.h"
 #include "Polyhedron_DefaultPayload.h"
+#include "SharedPointer.h"
+
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -31,10 +34,22 @@ namespace TrenchBroom {
         class BrushFace;
         
         typedef Polyhedron<FloatType, BrushFacePayload, BrushVertexPayload> BrushGeometry;
+        typedef std::shared_ptr<BrushGeometry> BrushGeometryPtr;
         
         void restoreFaceLinks(BrushGeometry* geometry);
         void restoreFaceLinks(BrushGeometry& geometry);
         
+        /**
+         Links the faces of the given geometry to the given brush faces, which must be given in the same order as the
+         geometry faces.
+         */
+        void linkFaces(BrushGeometry& geometry, const std::vector<BrushFace*>& faces);
+        
+        /**
+         Returns a copy of the given geometry whose faces are linked to the brush faces of the original.
+         */
+        BrushGeometryPtr copyGeometry(const BrushGeometry& geometry);
+        
         class SetTempFaceLinks {
         private:
             Brush* m_brush;
@@ -22,6 +22,9 @@
 #include "CollectionUtils.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/ModelUtils.h"
+#include "Model/TexCoordSystem.h"
 
 namespace TrenchBroom {
     namespace Model {
@@ -35,16 +38,33 @@ namespace TrenchBroom {
         }
 
         void BrushSnapshot::takeSnapshot(Brush* brush) {
-            for (BrushFace* face : brush->faces()) {
-                BrushFace *faceClone = face->clone();
+            // Share the geometry with the brush, it is copied if the brush modifies it in place. The faces are cloned
+            // in the order of the geometry faces so that they can be linked to it again on restore.
+            m_geometry = brush->m_geometry;
+            m_faces.reserve(m_geometry->faceCount());
+            
+            for (const BrushFaceGeometry* geometry : m_geometry->faces()) {
+                BrushFace *faceClone = geometry->payload()->clone();
                 faceClone->setTexture(nullptr);
                 m_faces.push_back(faceClone);
             }
         }
         
         void BrushSnapshot::doRestore(const BBox3& worldBounds) {
-            m_brush->setFaces(worldBounds, m_faces);
+            m_brush->restoreFaces(m_faces, m_geometry);
             m_faces.clear();
+            m_geometry.reset();
+        }
+
+        size_t BrushSnapshot::doGetMemoryUsage() const {
+            size_t result = sizeof(BrushSnapshot) + m_faces.capacity() * sizeof(BrushFace*);
+            result += m_faces.size() * (sizeof(BrushFace) + sizeof(TexCoordSystem));
+            
+            // The geometry is shared with the brush until the brush changes it, which is what commands usually do
+            // after taking a snapshot, so it is counted here.
+            if (m_geometry.get() != NULL)
+                result += estimateMemoryUsage(*m_geometry);
+            return result;
         }
     }
 }
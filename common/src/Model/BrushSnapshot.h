@@ -34,12 +34,14 @@ namespace TrenchBroom {
         private:
             Brush* m_brush;
             BrushFaceList m_faces;
+            BrushGeometryPtr m_geometry;
         public:
             BrushSnapshot(Brush* brush);
             ~BrushSnapshot();
         private:
             void takeSnapshot(Brush* brush);
             void doRestore(const BBox3& worldBounds);
+            size_t doGetMemoryUsage() const;
         };
     }
 }
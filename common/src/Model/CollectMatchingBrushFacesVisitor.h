@@ -37,6 +37,13 @@ namespace TrenchBroom {
         public:
             CollectMatchingBrushFacesVisitor(const P& p = P()) : m_p(p) {}
             const BrushFaceList& faces() const { return m_faces; }
+            
+            /**
+             Adds the faces collected by the given visitor, see parallelAcceptAndRecurse.
+             */
+            void merge(const CollectMatchingBrushFacesVisitor& other) {
+                VectorUtils::append(m_faces, other.m_faces);
+            }
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
@@ -25,6 +25,11 @@ namespace TrenchBroom {
     namespace Model {
         NodeCollectionStrategy::~NodeCollectionStrategy() {}
 
+        void NodeCollectionStrategy::addNodes(const NodeList& nodes) {
+            for (Node* node : nodes)
+                addNode(node);
+        }
+
         const NodeList& NodeCollectionStrategy::nodes() const {
             return m_nodes;
         }
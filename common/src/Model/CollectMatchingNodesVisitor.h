@@ -37,6 +37,7 @@ namespace TrenchBroom {
             virtual ~NodeCollectionStrategy();
             
             virtual void addNode(Node* node) = 0;
+            void addNodes(const NodeList& nodes);
             const NodeList& nodes() const;
         };
         
@@ -73,6 +74,11 @@ namespace TrenchBroom {
                 if (actual != NULL)
                     m_delegate.addNode(actual);
             }
+            
+            // the given nodes were collected by another instance of this strategy, so they are filtered already
+            void addNodes(const NodeList& nodes) {
+                m_delegate.addNodes(nodes);
+            }
         private:
             virtual Node* getNode(World* world) const   { return world;  }
             virtual Node* getNode(Layer* layer) const   { return layer;  }
@@ -89,6 +95,13 @@ namespace TrenchBroom {
         class CollectMatchingNodesVisitor : public C, public MatchingNodeVisitor<P,S> {
         public:
             CollectMatchingNodesVisitor(const P& p = P(), const S& s = S()) : MatchingNodeVisitor<P,S>(p, s) {}
+            
+            /**
+             Adds the nodes collected by the given visitor, see parallelAcceptAndRecurse.
+             */
+            void merge(const CollectMatchingNodesVisitor& other) {
+                C::addNodes(other.nodes());
+            }
         private:
             void doVisit(World* world)   { C::addNode(world);  }
             void doVisit(Layer* layer)   { C::addNode(layer);  }
@@ -33,6 +33,11 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
+        void ComputeNodeBoundsVisitor::merge(const ComputeNodeBoundsVisitor& other) {
+            if (other.m_initialized)
+                mergeWith(other.m_bounds);
+        }
+
         void ComputeNodeBoundsVisitor::doVisit(const World* world) {}
         void ComputeNodeBoundsVisitor::doVisit(const Layer* layer) {}
         
@@ -34,6 +34,12 @@ namespace TrenchBroom {
             BBox3 m_bounds;
             ComputeNodeBoundsVisitor(const BBox3& defaultBounds = BBox3());
             const BBox3& bounds() const;
+            
+            /**
+             Merges the bounds computed by the given visitor into the bounds of this visitor, see
+             parallelAcceptAndRecurse.
+             */
+            void merge(const ComputeNodeBoundsVisitor& other);
         private:
             void doVisit(const World* world);
             void doVisit(const Layer* layer);
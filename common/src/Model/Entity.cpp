@@ -31,6 +31,7 @@
 #include "Model/IssueGenerator.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PickResult.h"
+#include "Model/TransformObjectVisitor.h"
 
 namespace TrenchBroom {
     namespace Model {
@@ -264,29 +265,10 @@ namespace TrenchBroom {
             return visitor.hasResult() ? visitor.result() : NULL;
         }
 
-        class TransformEntity : public NodeVisitor {
-        private:
-            const Mat4x4d& m_transformation;
-            bool m_lockTextures;
-            const BBox3& m_worldBounds;
-        public:
-            TransformEntity(const Mat4x4d& transformation, const bool lockTextures, const BBox3& worldBounds) :
-            m_transformation(transformation),
-            m_lockTextures(lockTextures),
-            m_worldBounds(worldBounds) {}
-        private:
-            void doVisit(World* world)   {}
-            void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   {}
-            void doVisit(Entity* entity) {}
-            void doVisit(Brush* brush)   { brush->transform(m_transformation, m_lockTextures, m_worldBounds); }
-        };
-
         void Entity::doTransform(const Mat4x4& transformation, const bool lockTextures, const BBox3& worldBounds) {
             if (hasChildren()) {
                 const NotifyNodeChange nodeChange(this);
-                TransformEntity visitor(transformation, lockTextures, worldBounds);
-                iterate(visitor);
+                transformObjects(children(), transformation, lockTextures, worldBounds);
             } else {
                 // node change is called by setOrigin already
                 const Vec3 bottomCenter = Vec3(bounds().center().xy(), bounds().min.z());
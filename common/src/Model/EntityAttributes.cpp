@@ -20,6 +20,7 @@
 #include "EntityAttributes.h"
 
 #include "Exceptions.h"
+#include "StringPool.h"
 #include "Assets/EntityDefinition.h"
 
 namespace TrenchBroom {
@@ -87,11 +88,17 @@ namespace TrenchBroom {
 
         const EntityAttribute::List EntityAttribute::EmptyList(0);
         
+        static const AttributeName* internName(const AttributeName& name) {
+            static StringPool pool;
+            return &pool.intern(name);
+        }
+        
         EntityAttribute::EntityAttribute() :
+        m_name(internName(EmptyString)),
         m_definition(NULL) {}
         
         EntityAttribute::EntityAttribute(const AttributeName& name, const AttributeValue& value, const Assets::AttributeDefinition* definition) :
-        m_name(name),
+        m_name(internName(name)),
         m_value(value),
         m_definition(definition) {}
         
@@ -100,14 +107,14 @@ namespace TrenchBroom {
         }
         
         int EntityAttribute::compare(const EntityAttribute& rhs) const {
-            const int nameCmp = m_name.compare(rhs.m_name);
-            if (nameCmp != 0)
-                return nameCmp;
+            // interned names are equal only if they are the same object
+            if (m_name != rhs.m_name)
+                return m_name->compare(*rhs.m_name);
             return m_value.compare(rhs.m_value);
         }
 
         const AttributeName& EntityAttribute::name() const {
-            return m_name;
+            return *m_name;
         }
         
         const AttributeValue& EntityAttribute::value() const {
@@ -119,7 +126,7 @@ namespace TrenchBroom {
         }
 
         void EntityAttribute::setName(const AttributeName& name, const Assets::AttributeDefinition* definition) {
-            m_name = name;
+            m_name = internName(name);
             m_definition = definition;
         }
         
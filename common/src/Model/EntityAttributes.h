@@ -80,7 +80,8 @@ namespace TrenchBroom {
             typedef std::list<EntityAttribute> List;
             static const List EmptyList;
         private:
-            AttributeName m_name;
+            // attribute names repeat a lot, so they are interned
+            const AttributeName* m_name;
             AttributeValue m_value;
             const Assets::AttributeDefinition* m_definition;
         public:
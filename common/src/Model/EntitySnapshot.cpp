@@ -48,5 +48,10 @@ namespace TrenchBroom {
             restoreAttribute(m_entity, m_origin);
             restoreAttribute(m_entity, m_rotation);
         }
+
+        size_t EntitySnapshot::doGetMemoryUsage() const {
+            // attribute names are interned and shared with the entity
+            return sizeof(EntitySnapshot) + m_origin.value().capacity() + m_rotation.value().capacity();
+        }
     }
 }
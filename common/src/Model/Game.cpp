@@ -78,6 +78,11 @@ namespace TrenchBroom {
             doWriteMap(world, path);
         }
 
+        void Game::writeMapToStream(World* world, std::ostream& stream) const {
+            ensure(world != nullptr, "world is null");
+            doWriteMapToStream(world, stream);
+        }
+
         void Game::exportMap(World* world, const Model::ExportFormat format, const IO::Path& path) const {
             ensure(world != nullptr, "world is null");
             doExportMap(world, format, path);
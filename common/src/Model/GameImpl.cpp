@@ -162,6 +162,13 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        void GameImpl::doWriteMapToStream(World* world, std::ostream& stream) const {
+            IO::writeGameComment(stream, gameName(), formatName(world->format()));
+
+            IO::NodeWriter writer(world, stream);
+            writer.writeMap();
+        }
+
         void GameImpl::doExportMap(World* world, const Model::ExportFormat format, const IO::Path& path) const {
             IO::OpenFile open(path, true);
 
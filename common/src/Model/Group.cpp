@@ -226,8 +226,7 @@ namespace TrenchBroom {
         }
 
         void Group::doTransform(const Mat4x4& transformation, const bool lockTextures, const BBox3& worldBounds) {
-            TransformObjectVisitor visitor(transformation, lockTextures, worldBounds);
-            iterate(visitor);
+            transformObjects(children(), transformation, lockTextures, worldBounds);
         }
         
         bool Group::doContains(const Node* node) const {
@@ -48,5 +48,12 @@ namespace TrenchBroom {
             for (NodeSnapshot* snapshot : m_snapshots)
                 snapshot->restore(worldBounds);
         }
+
+        size_t GroupSnapshot::doGetMemoryUsage() const {
+            size_t result = sizeof(GroupSnapshot) + m_snapshots.capacity() * sizeof(NodeSnapshot*);
+            for (const NodeSnapshot* snapshot : m_snapshots)
+                result += snapshot->memoryUsage();
+            return result;
+        }
     }
 }
@@ -19,28 +19,39 @@
 
 #include "Layer.h"
 
+#include "CollectionUtils.h"
+
 #include "Model/Brush.h"
 #include "Model/Group.h"
 #include "Model/Entity.h"
 #include "Model/IssueGenerator.h"
 #include "Model/NodeVisitor.h"
+#include "Model/PickResult.h"
 
 namespace TrenchBroom {
     namespace Model {
+        // nodes that move by less than this do not change the tree, which keeps dragging them cheap
+        static const FloatType NodeTreeMargin = 8.0;
+
         Layer::Layer(const String& name, const BBox3& worldBounds) :
         m_name(name),
-        m_octree(worldBounds, static_cast<FloatType>(64.0f)) {}
+        m_worldBounds(worldBounds),
+        m_nodeTree(NodeTreeMargin) {}
         
         void Layer::setName(const String& name) {
             m_name = name;
         }
 
+        void Layer::findNodesIntersecting(const BBox3& bounds, NodeList& result) const {
+            VectorUtils::append(result, m_nodeTree.findIntersectingObjects(bounds));
+        }
+
         const String& Layer::doGetName() const {
             return m_name;
         }
 
         const BBox3& Layer::doGetBounds() const {
-            return m_octree.bounds();
+            return m_worldBounds;
         }
 
         Node* Layer::doClone(const BBox3& worldBounds) const {
@@ -73,60 +84,60 @@ namespace TrenchBroom {
             return false;
         }
 
-        class Layer::AddNodeToOctree : public NodeVisitor {
+        class Layer::AddNodeToTree : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            NodeTree& m_nodeTree;
         public:
-            AddNodeToOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            AddNodeToTree(NodeTree& nodeTree) :
+            m_nodeTree(nodeTree) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.addObject(group->bounds(), group); }
-            void doVisit(Entity* entity) { m_octree.addObject(entity->bounds(), entity); }
-            void doVisit(Brush* brush)   { m_octree.addObject(brush->bounds(), brush); }
+            void doVisit(Group* group)   { m_nodeTree.addObject(group->bounds(), group); }
+            void doVisit(Entity* entity) { m_nodeTree.addObject(entity->bounds(), entity); }
+            void doVisit(Brush* brush)   { m_nodeTree.addObject(brush->bounds(), brush); }
         };
         
-        class Layer::RemoveNodeFromOctree : public NodeVisitor {
+        class Layer::RemoveNodeFromTree : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            NodeTree& m_nodeTree;
         public:
-            RemoveNodeFromOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            RemoveNodeFromTree(NodeTree& nodeTree) :
+            m_nodeTree(nodeTree) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.removeObject(group); }
-            void doVisit(Entity* entity) { m_octree.removeObject(entity); }
-            void doVisit(Brush* brush)   { m_octree.removeObject(brush); }
+            void doVisit(Group* group)   { m_nodeTree.removeObject(group); }
+            void doVisit(Entity* entity) { m_nodeTree.removeObject(entity); }
+            void doVisit(Brush* brush)   { m_nodeTree.removeObject(brush); }
         };
         
-        class Layer::UpdateNodeInOctree : public NodeVisitor {
+        class Layer::UpdateNodeInTree : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            NodeTree& m_nodeTree;
         public:
-            UpdateNodeInOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            UpdateNodeInTree(NodeTree& nodeTree) :
+            m_nodeTree(nodeTree) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.updateObject(group->bounds(), group); }
-            void doVisit(Entity* entity) { m_octree.updateObject(entity->bounds(), entity); }
-            void doVisit(Brush* brush)   { m_octree.updateObject(brush->bounds(), brush); }
+            void doVisit(Group* group)   { m_nodeTree.updateObject(group->bounds(), group); }
+            void doVisit(Entity* entity) { m_nodeTree.updateObject(entity->bounds(), entity); }
+            void doVisit(Brush* brush)   { m_nodeTree.updateObject(brush->bounds(), brush); }
         };
 
         void Layer::doChildWasAdded(Node* node) {
-            AddNodeToOctree visitor(m_octree);
+            AddNodeToTree visitor(m_nodeTree);
             node->accept(visitor);
         }
         
         void Layer::doChildWillBeRemoved(Node* node) {
-            RemoveNodeFromOctree visitor(m_octree);
+            RemoveNodeFromTree visitor(m_nodeTree);
             node->accept(visitor);
         }
         
         void Layer::doChildBoundsDidChange(Node* node) {
-            UpdateNodeInOctree visitor(m_octree);
+            UpdateNodeInTree visitor(m_nodeTree);
             node->accept(visitor);
         }
 
@@ -147,12 +158,14 @@ namespace TrenchBroom {
         }
 
         void Layer::doPick(const Ray3& ray, PickResult& pickResult) const {
-            for (const Node* node : m_octree.findObjects(ray))
+            m_nodeTree.findObjects(ray, [&ray, &pickResult](const Node* node) {
                 node->pick(ray, pickResult);
+                return pickResult.maxDistance();
+            });
         }
         
         void Layer::doFindNodesContaining(const Vec3& point, NodeList& result) {
-            for (Node* node : m_octree.findObjects(point))
+            for (Node* node : m_nodeTree.findObjects(point))
                 node->findNodesContaining(point, result);
         }
 
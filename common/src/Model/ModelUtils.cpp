@@ -19,6 +19,19 @@
 
 #include "ModelUtils.h"
 
+#include "CollectionUtils.h"
+#include "ParallelUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/CollectMatchingNodesVisitor.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/TexCoordSystem.h"
+#include "Model/World.h"
+
+#include <unordered_set>
+
 namespace TrenchBroom {
     namespace Model {
         Model::NodeList collectParents(const Model::NodeList& nodes) {
@@ -54,5 +67,104 @@ namespace TrenchBroom {
             
             return result;
         }
+        
+        static size_t estimateGeometryMemoryUsage(const size_t vertexCount, const size_t edgeCount, const size_t faceCount) {
+            return (sizeof(BrushGeometry) +
+                    vertexCount * sizeof(BrushVertex) +
+                    edgeCount * (sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge)) +
+                    faceCount * sizeof(BrushFaceGeometry));
+        }
+        
+        class EstimateMemoryUsage : public ConstNodeVisitor {
+        private:
+            size_t m_result;
+        public:
+            EstimateMemoryUsage() :
+            m_result(0) {}
+            
+            size_t result() const {
+                return m_result;
+            }
+        private:
+            void doVisit(const World* world)   { m_result += sizeof(World) + estimateAttributes(world); }
+            void doVisit(const Layer* layer)   { m_result += sizeof(Layer); }
+            void doVisit(const Group* group)   { m_result += sizeof(Group); }
+            void doVisit(const Entity* entity) { m_result += sizeof(Entity) + estimateAttributes(entity); }
+            void doVisit(const Brush* brush)   {
+                // the face geometry is counted as part of the geometry
+                m_result += sizeof(Brush) + brush->faceCount() * (sizeof(BrushFace*) + sizeof(BrushFace) + sizeof(TexCoordSystem));
+                m_result += estimateGeometryMemoryUsage(brush->vertexCount(), brush->edgeCount(), brush->faceCount());
+            }
+            
+            static size_t estimateAttributes(const AttributableNode* node) {
+                // attribute names are interned and shared between all nodes
+                size_t result = 0;
+                for (const EntityAttribute& attribute : node->attributes())
+                    result += sizeof(EntityAttribute) + 2 * sizeof(void*) + attribute.value().capacity();
+                return result;
+            }
+        };
+        
+        size_t estimateMemoryUsage(const Model::NodeList& nodes) {
+            EstimateMemoryUsage visitor;
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            return visitor.result();
+        }
+        
+        size_t estimateMemoryUsage(const Model::ParentChildrenMap& nodes) {
+            size_t result = estimateReferenceMemoryUsage(nodes);
+            for (const auto& entry : nodes)
+                result += estimateMemoryUsage(entry.second);
+            return result;
+        }
+        
+        size_t estimateMemoryUsage(const Model::BrushGeometry& geometry) {
+            return estimateGeometryMemoryUsage(geometry.vertexCount(), geometry.edgeCount(), geometry.faceCount());
+        }
+        
+        size_t estimateReferenceMemoryUsage(const Model::ParentChildrenMap& nodes) {
+            size_t result = 0;
+            for (const auto& entry : nodes)
+                result += sizeof(entry) + entry.second.capacity() * sizeof(Node*);
+            return result;
+        }
+        
+        Model::NodeList collectNodesIntersecting(const Model::World* world, const Model::BrushList& brushes) {
+            Model::NodeList candidates;
+            for (const Model::Layer* layer : world->allLayers()) {
+                for (const Model::Brush* brush : brushes)
+                    layer->findNodesIntersecting(brush->bounds(), candidates);
+            }
+            
+            // keep the order in which the nodes were found so that the result does not depend on their addresses
+            Model::NodeList result;
+            result.reserve(candidates.size());
+            
+            std::unordered_set<Model::Node*> found;
+            for (Model::Node* node : candidates) {
+                if (found.insert(node).second)
+                    result.push_back(node);
+            }
+            return result;
+        }
+
+        class MatchNodesWithInvalidIssues {
+        public:
+            bool operator()(const Model::Node* node) const {
+                return !node->issuesValid();
+            }
+        };
+
+        void validateIssues(Model::World* world, const Model::IssueGeneratorList& issueGenerators) {
+            // the missing mod generator remembers the mods of the worldspawn entity, so the world is validated here
+            world->issues(issueGenerators);
+
+            Model::CollectMatchingNodesVisitor<MatchNodesWithInvalidIssues> visitor;
+            world->recurse(visitor);
+
+            ParallelUtils::parallelForEach(visitor.nodes(), [&issueGenerators](Model::Node* node) {
+                node->issues(issueGenerators);
+            });
+        }
     }
 }
@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_ModelUtils
 #define TrenchBroom_ModelUtils
 
+#include "Model/AttributableNode.h"
 #include "Model/CollectUniqueNodesVisitor.h"
 #include "Model/ModelTypes.h"
 #include "Model/Node.h"
@@ -38,6 +39,60 @@ namespace TrenchBroom {
 
         Model::NodeList collectChildren(const Model::ParentChildrenMap& nodes);
         Model::ParentChildrenMap parentChildrenMap(const Model::NodeList& nodes);
+        
+        /**
+         Returns an estimate of the number of bytes occupied by the given nodes and their descendants, including the
+         faces and geometry of brushes.
+         */
+        size_t estimateMemoryUsage(const Model::NodeList& nodes);
+        size_t estimateMemoryUsage(const Model::ParentChildrenMap& nodes);
+        size_t estimateMemoryUsage(const Model::BrushGeometry& geometry);
+        
+        /**
+         Returns an estimate of the number of bytes occupied by the given map, without the nodes that it refers to.
+         */
+        size_t estimateReferenceMemoryUsage(const Model::ParentChildrenMap& nodes);
+        
+        /**
+         Returns the children of the layers of the given world whose bounds may intersect the bounds of any of the given
+         brushes. Only these nodes and their descendants can touch or be contained in one of the brushes. Each node is
+         returned once, in the order in which it was first found.
+         */
+        Model::NodeList collectNodesIntersecting(const Model::World* world, const Model::BrushList& brushes);
+
+        /**
+         Returns the given nodes and all nodes that are linked to them by target or killtarget attributes, directly or
+         through other nodes and in either direction. Only nodes that match the given predicate are added and
+         followed.
+         */
+        template <typename P>
+        Model::AttributableNodeList collectLinkedNodes(const Model::AttributableNodeList& nodes, const P& p) {
+            Model::AttributableNodeList result;
+            Model::AttributableNodeSet visited;
+            const auto add = [&](const Model::AttributableNodeList& candidates) {
+                for (Model::AttributableNode* candidate : candidates) {
+                    if (p(candidate) && visited.insert(candidate).second)
+                        result.push_back(candidate);
+                }
+            };
+            
+            // the result doubles as the queue of nodes whose links have yet to be followed
+            add(nodes);
+            for (size_t i = 0; i < result.size(); ++i) {
+                const Model::AttributableNode* node = result[i];
+                add(node->linkSources());
+                add(node->linkTargets());
+                add(node->killSources());
+                add(node->killTargets());
+            }
+            return result;
+        }
+
+        /**
+         Generates the issues of every node of the given world whose issues are invalid. The issue generators only read
+         the node they are passed, so the descendants of the world are validated concurrently.
+         */
+        void validateIssues(Model::World* world, const Model::IssueGeneratorList& issueGenerators);
     }
 }
 
@@ -553,6 +553,10 @@ namespace TrenchBroom {
             return m_issues;
         }
         
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
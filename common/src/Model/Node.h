@@ -242,6 +242,7 @@ namespace TrenchBroom {
             bool containsLine(size_t lineNumber) const;
         public: // issue management
             const IssueList& issues(const IssueGeneratorList& issueGenerators);
+            bool issuesValid() const;
             
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
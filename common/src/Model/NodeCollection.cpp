@@ -38,46 +38,63 @@ namespace TrenchBroom {
             m_collection(collection) {}
         private:
             void doVisit(World* world)   {}
-            void doVisit(Layer* layer)   { m_collection.m_nodes.push_back(layer);  m_collection.m_layers.push_back(layer); }
-            void doVisit(Group* group)   { m_collection.m_nodes.push_back(group);  m_collection.m_groups.push_back(group); }
-            void doVisit(Entity* entity) { m_collection.m_nodes.push_back(entity); m_collection.m_entities.push_back(entity); }
-            void doVisit(Brush* brush)   { m_collection.m_nodes.push_back(brush);  m_collection.m_brushes.push_back(brush); }
+            void doVisit(Layer* layer)   { add(m_collection.m_layers, layer);     }
+            void doVisit(Group* group)   { add(m_collection.m_groups, group);     }
+            void doVisit(Entity* entity) { add(m_collection.m_entities, entity);  }
+            void doVisit(Brush* brush)   { add(m_collection.m_brushes, brush);    }
+
+            template <typename V, typename E>
+            void add(V& collection, E* elem) {
+                if (m_collection.m_nodeSet.insert(elem).second) {
+                    m_collection.m_nodes.push_back(elem);
+                    collection.push_back(elem);
+                }
+            }
         };
 
         class NodeCollection::RemoveNode : public NodeVisitor {
         private:
             NodeCollection& m_collection;
-            NodeList::iterator m_nodeRem;
-            LayerList::iterator m_layerRem;
-            GroupList::iterator m_groupRem;
-            EntityList::iterator m_entityRem;
-            BrushList::iterator m_brushRem;
+            bool m_layers;
+            bool m_groups;
+            bool m_entities;
+            bool m_brushes;
         public:
             RemoveNode(NodeCollection& collection) :
             m_collection(collection),
-            m_nodeRem(std::end(m_collection.m_nodes)),
-            m_layerRem(std::end(m_collection.m_layers)),
-            m_groupRem(std::end(m_collection.m_groups)),
-            m_entityRem(std::end(m_collection.m_entities)),
-            m_brushRem(std::end(m_collection.m_brushes)) {}
+            m_layers(false),
+            m_groups(false),
+            m_entities(false),
+            m_brushes(false) {}
             
             ~RemoveNode() {
-                m_collection.m_nodes.erase(m_nodeRem, std::end(m_collection.m_nodes));
-                m_collection.m_layers.erase(m_layerRem, std::end(m_collection.m_layers));
-                m_collection.m_groups.erase(m_groupRem, std::end(m_collection.m_groups));
-                m_collection.m_entities.erase(m_entityRem, std::end(m_collection.m_entities));
-                m_collection.m_brushes.erase(m_brushRem, std::end(m_collection.m_brushes));
+                if (m_layers || m_groups || m_entities || m_brushes)
+                    compact(m_collection.m_nodes);
+                if (m_layers)
+                    compact(m_collection.m_layers);
+                if (m_groups)
+                    compact(m_collection.m_groups);
+                if (m_entities)
+                    compact(m_collection.m_entities);
+                if (m_brushes)
+                    compact(m_collection.m_brushes);
             }
         private:
             void doVisit(World* world)   {}
-            void doVisit(Layer* layer)   { remove(m_collection.m_nodes, m_nodeRem, layer);  remove(m_collection.m_layers, m_layerRem, layer); }
-            void doVisit(Group* group)   { remove(m_collection.m_nodes, m_nodeRem, group);  remove(m_collection.m_groups, m_groupRem, group); }
-            void doVisit(Entity* entity) { remove(m_collection.m_nodes, m_nodeRem, entity); remove(m_collection.m_entities, m_entityRem, entity); }
-            void doVisit(Brush* brush)   { remove(m_collection.m_nodes, m_nodeRem, brush);  remove(m_collection.m_brushes, m_brushRem, brush); }
+            void doVisit(Layer* layer)   { m_layers   |= remove(layer);  }
+            void doVisit(Group* group)   { m_groups   |= remove(group);  }
+            void doVisit(Entity* entity) { m_entities |= remove(entity); }
+            void doVisit(Brush* brush)   { m_brushes  |= remove(brush);  }
             
-            template <typename V, typename E>
-            void remove(V& collection, typename V::iterator& rem, E& elem) {
-                rem = std::remove(std::begin(collection), rem, elem);
+            bool remove(const Node* node) {
+                return m_collection.m_nodeSet.erase(node) > 0;
+            }
+
+            template <typename V>
+            void compact(V& collection) {
+                const NodeSet& nodeSet = m_collection.m_nodeSet;
+                const auto rem = std::remove_if(std::begin(collection), std::end(collection), [&nodeSet](const Node* node) { return nodeSet.count(node) == 0; });
+                collection.erase(rem, std::end(collection));
             }
         };
 
@@ -137,6 +154,10 @@ namespace TrenchBroom {
             return !empty() && nodeCount() == brushCount();
         }
 
+        bool NodeCollection::contains(const Node* node) const {
+            return m_nodeSet.count(node) > 0;
+        }
+
         NodeList::iterator NodeCollection::begin() {
             return std::begin(m_nodes);
         }
@@ -196,6 +217,7 @@ namespace TrenchBroom {
         }
 
         void NodeCollection::clear() {
+            m_nodeSet.clear();
             m_nodes.clear();
             m_layers.clear();
             m_groups.clear();
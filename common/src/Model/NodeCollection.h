@@ -23,13 +23,21 @@
 #include "Model/ModelTypes.h"
 #include "Model/NodeVisitor.h"
 
+#include <unordered_set>
+
 namespace TrenchBroom {
     namespace Model {
+        /**
+         A collection of distinct nodes that keeps separate lists per node type. Membership tests are constant time, and
+         removing any number of nodes takes a single pass over the lists.
+         */
         class NodeCollection {
         private:
             class AddNode;
             class RemoveNode;
+            typedef std::unordered_set<const Node*> NodeSet;
         private:
+            NodeSet m_nodeSet;
             NodeList m_nodes;
             LayerList m_layers;
             GroupList m_groups;
@@ -52,6 +60,8 @@ namespace TrenchBroom {
             bool hasBrushes() const;
             bool hasOnlyBrushes() const;
 
+            bool contains(const Node* node) const;
+
             NodeList::iterator begin();
             NodeList::iterator end();
             NodeList::const_iterator begin() const;
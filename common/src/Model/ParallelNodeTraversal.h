@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ParallelNodeTraversal
+#define TrenchBroom_ParallelNodeTraversal
+
+#include "ParallelUtils.h"
+#include "Model/Node.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         Visits the given node and its descendants that have children, and collects the descendants without children
+         in the order in which acceptAndRecurse would visit them.
+         */
+        template <typename N, typename V>
+        void acceptContainersAndCollectLeaves(N* node, V& visitor, std::vector<N*>& leaves) {
+            static_assert(std::is_same<typename std::remove_const<N>::type, Node>::value, "N must be Node or const Node");
+
+            node->accept(visitor);
+            if (visitor.recursionStopped())
+                return;
+
+            for (N* child : node->children()) {
+                if (visitor.cancelled())
+                    return;
+                if (child->hasChildren())
+                    acceptContainersAndCollectLeaves(child, visitor, leaves);
+                else
+                    leaves.push_back(child);
+            }
+        }
+
+        /**
+         Visits the given node and its descendants like acceptAndRecurse, but splits the tree at layer, group and entity
+         boundaries so that read-only queries can use all cores. The given visitor visits every node that has children
+         on the calling thread. The remaining nodes, mostly brushes, are split into contiguous tasks. Each task is
+         visited by its own copy of the visitor as it was passed in, so the visitor must not have visited any nodes yet.
+         Afterwards, the task visitors are merged into the given visitor in task order by calling
+         visitor.merge(taskVisitor), so the result does not depend on how the tasks were scheduled. The nodes with
+         children come first in the result, followed by the other nodes in the order of acceptAndRecurse.
+
+         The visitors must be safe to run concurrently on different nodes. They must not change the nodes, and they
+         must not cancel the traversal, because cancelling only stops the task that the visitor belongs to.
+         */
+        template <typename N, typename V>
+        void parallelAcceptAndRecurse(N* node, V& visitor, const size_t minNodesPerTask = 256) {
+            typedef typename std::conditional<std::is_const<N>::value, const Node, Node>::type NodeType;
+            const V prototype(visitor);
+
+            std::vector<NodeType*> leaves;
+            acceptContainersAndCollectLeaves(static_cast<NodeType*>(node), visitor, leaves);
+            if (visitor.cancelled())
+                return;
+
+            // the recursion flag is reset after visiting a leaf so that it cannot affect a later traversal
+            const size_t taskCount = std::min(4 * ParallelUtils::threadCount(), leaves.size() / std::max(static_cast<size_t>(1), minNodesPerTask));
+            if (taskCount <= 1) {
+                for (NodeType* leaf : leaves) {
+                    leaf->accept(visitor);
+                    visitor.recursionStopped();
+                }
+                return;
+            }
+
+            std::vector<V> taskVisitors(taskCount, prototype);
+            ParallelUtils::parallelFor(taskCount, [&](const size_t task) {
+                const size_t first = task * leaves.size() / taskCount;
+                const size_t last = (task + 1) * leaves.size() / taskCount;
+                V& taskVisitor = taskVisitors[task];
+                for (size_t i = first; i < last; ++i) {
+                    leaves[i]->accept(taskVisitor);
+                    taskVisitor.recursionStopped();
+                }
+            }, 1, 1);
+
+            for (const V& taskVisitor : taskVisitors)
+                visitor.merge(taskVisitor);
+        }
+    }
+}
+
+#endif /* defined(TrenchBroom_ParallelNodeTraversal) */
@@ -21,6 +21,8 @@
 
 #include "Model/CompareHits.h"
 
+#include <limits>
+
 namespace TrenchBroom {
     namespace Model {
         class PickResult::CompareWrapper {
@@ -31,9 +33,15 @@ namespace TrenchBroom {
             bool operator()(const Hit& lhs, const Hit& rhs) const { return m_compare->compare(lhs, rhs) < 0; }
         };
         
+        PickResult::PickResult(const EditorContext& editorContext, CompareHits* compare) :
+        m_editorContext(&editorContext),
+        m_compare(compare),
+        m_maxDistance(std::numeric_limits<FloatType>::infinity()) {}
+
         PickResult::PickResult() :
         m_editorContext(NULL),
-        m_compare(new CompareHitsByDistance()) {}
+        m_compare(new CompareHitsByDistance()),
+        m_maxDistance(std::numeric_limits<FloatType>::infinity()) {}
 
         PickResult PickResult::byDistance(const EditorContext& editorContext) {
             CompareHits* compare = new CombineCompareHits(new CompareHitsByDistance(),
@@ -45,6 +53,13 @@ namespace TrenchBroom {
             return PickResult(editorContext, new CompareHitsBySize(axis));
         }
 
+        PickResult PickResult::nearest(const EditorContext& editorContext, HitFilter* filter) {
+            ensure(filter != NULL, "filter is null");
+            PickResult result = byDistance(editorContext);
+            result.m_nearestFilter = FilterPtr(filter);
+            return result;
+        }
+
         bool PickResult::empty() const {
             return m_hits.empty();
         }
@@ -53,8 +68,21 @@ namespace TrenchBroom {
             return m_hits.size();
         }
         
+        FloatType PickResult::maxDistance() const {
+            return m_maxDistance;
+        }
+
         void PickResult::addHit(const Hit& hit) {
             ensure(m_compare.get() != NULL, "compare is null");
+            if (m_nearestFilter.get() != NULL) {
+                if (hit.distance() > m_maxDistance || !m_nearestFilter->matches(hit))
+                    return;
+                if (hit.distance() < m_maxDistance) {
+                    m_maxDistance = hit.distance();
+                    m_hits.clear();
+                }
+            }
+            
             Hit::List::iterator pos = std::upper_bound(std::begin(m_hits), std::end(m_hits), hit, CompareWrapper(m_compare.get()));
             m_hits.insert(pos, hit);
         }
@@ -34,24 +34,36 @@ namespace TrenchBroom {
         class PickResult {
         public:
             typedef std::shared_ptr<CompareHits> ComparePtr;
+            typedef std::shared_ptr<HitFilter> FilterPtr;
         private:
             const EditorContext* m_editorContext;
             Hit::List m_hits;
             ComparePtr m_compare;
+            FilterPtr m_nearestFilter;
+            FloatType m_maxDistance;
             class CompareWrapper;
         public:
-            PickResult(const EditorContext& editorContext, CompareHits* compare) :
-            m_editorContext(&editorContext),
-            m_compare(compare) {}
-
+            PickResult(const EditorContext& editorContext, CompareHits* compare);
             PickResult();
 
             static PickResult byDistance(const EditorContext& editorContext);
             static PickResult bySize(const EditorContext& editorContext, Math::Axis::Type axis);
+            
+            /**
+             Creates a pick result that only keeps the nearest hits that match the given filter. Since no hit behind
+             them can make it into the result, the picked nodes can skip everything beyond maxDistance().
+             */
+            static PickResult nearest(const EditorContext& editorContext, HitFilter* filter);
 
             bool empty() const;
             size_t size() const;
 
+            /**
+             Returns the distance beyond which hits are not needed anymore. This is infinity unless this pick result
+             only keeps the nearest hits.
+             */
+            FloatType maxDistance() const;
+            
             void addHit(const Hit& hit);
 
             const Hit::List& all() const;
@@ -34,9 +34,11 @@ namespace TrenchBroom {
         private:
             NodeSnapshotList m_nodeSnapshots;
             BrushFaceSnapshotList m_brushFaceSnapshots;
+            size_t m_memoryUsage;
         public:
             template <typename I>
-            Snapshot(I cur, I end) {
+            Snapshot(I cur, I end) :
+            m_memoryUsage(sizeof(Snapshot)) {
                 while (cur != end) {
                     takeSnapshot(*cur);
                     ++cur;
@@ -47,6 +49,11 @@ namespace TrenchBroom {
             
             void restoreNodes(const BBox3& worldBounds);
             void restoreBrushFaces();
+            
+            /**
+             Returns an estimate of the number of bytes that this snapshot occupies.
+             */
+            size_t memoryUsage() const;
         private:
             void takeSnapshot(Node* node);
             void takeSnapshot(BrushFace* face);
@@ -19,6 +19,7 @@
 
 #include "TransformObjectVisitor.h"
 
+#include "Model/AssortNodesVisitor.h"
 #include "Model/Brush.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
@@ -35,5 +36,15 @@ namespace TrenchBroom {
         void TransformObjectVisitor::doVisit(Group* group)   {  group->transform(m_transformation, m_lockTextures, m_worldBounds); }
         void TransformObjectVisitor::doVisit(Entity* entity) { entity->transform(m_transformation, m_lockTextures, m_worldBounds); }
         void TransformObjectVisitor::doVisit(Brush* brush)   {  brush->transform(m_transformation, m_lockTextures, m_worldBounds); }
+
+        void transformObjects(const NodeList& nodes, const Mat4x4d& transformation, const bool lockTextures, const BBox3& worldBounds) {
+            CollectObjectsVisitor collect;
+            Node::accept(std::begin(nodes), std::end(nodes), collect);
+            
+            TransformObjectVisitor transform(transformation, lockTextures, worldBounds);
+            Node::accept(std::begin(collect.groups()), std::end(collect.groups()), transform);
+            Node::accept(std::begin(collect.entities()), std::end(collect.entities()), transform);
+            Brush::transformBrushes(collect.brushes(), transformation, lockTextures, worldBounds);
+        }
     }
 }
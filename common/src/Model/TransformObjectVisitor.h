@@ -40,6 +40,12 @@ namespace TrenchBroom {
             void doVisit(Entity* entity);
             void doVisit(Brush* brush);
         };
+
+        /**
+         Transforms the given objects. Groups and entities are transformed one by one, but the brushes are transformed
+         as a batch so that their geometry can be rebuilt in parallel.
+         */
+        void transformObjects(const NodeList& nodes, const Mat4x4d& transformation, bool lockTextures, const BBox3& worldBounds);
     }
 }
 
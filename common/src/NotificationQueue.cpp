@@ -0,0 +1,51 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotificationQueue.h"
+
+namespace TrenchBroom {
+    NotificationQueue::NotificationQueue() :
+    m_hasPending(false) {}
+
+    void NotificationQueue::post(const Notification& notification) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(notification);
+        m_hasPending = true;
+    }
+
+    bool NotificationQueue::hasPending() const {
+        return m_hasPending;
+    }
+
+    size_t NotificationQueue::drain() {
+        if (!m_hasPending)
+            return 0;
+
+        List notifications;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            notifications.swap(m_pending);
+            m_hasPending = false;
+        }
+
+        for (const Notification& notification : notifications)
+            notification();
+        return notifications.size();
+    }
+}
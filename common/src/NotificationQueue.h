@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_NotificationQueue_h
+#define TrenchBroom_NotificationQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     Passes notifications from worker threads to the thread that owns the notifiers, usually the UI thread. Notifications
+     can be posted from any thread, but they are only delivered when the owning thread drains the queue. Since notifiers
+     are not thread-safe, this is the only way for a worker to notify observers.
+     */
+    class NotificationQueue {
+    public:
+        typedef std::function<void()> Notification;
+    private:
+        typedef std::vector<Notification> List;
+
+        List m_pending;
+        std::atomic<bool> m_hasPending;
+        mutable std::mutex m_mutex;
+    public:
+        NotificationQueue();
+
+        /**
+         Adds the given notification to this queue. Can be called from any thread.
+         */
+        void post(const Notification& notification);
+
+        /**
+         Posts a notification that calls the given notifier with copies of the given arguments. The notifier must outlive
+         the next call to drain.
+         */
+        template <typename N, typename... A>
+        void notify(N& notifier, const A&... args) {
+            post([&notifier, args...]() { notifier(args...); });
+        }
+
+        /**
+         Indicates whether any notifications are pending. Does not lock the queue, so this is cheap enough to call
+         whenever the owning thread is idle.
+         */
+        bool hasPending() const;
+
+        /**
+         Delivers all pending notifications on the calling thread, in the order in which they were posted, and returns
+         their number. The queue is only locked to take the pending notifications, so workers are not blocked while they
+         are delivered. Notifications posted during delivery are delivered by the next call.
+         */
+        size_t drain();
+    private:
+        NotificationQueue(const NotificationQueue& other);
+        NotificationQueue& operator=(const NotificationQueue& other);
+    };
+}
+
+#endif
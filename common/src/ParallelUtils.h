@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ParallelUtils_h
+#define TrenchBroom_ParallelUtils_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace ParallelUtils {
+    /**
+     Returns the number of threads that parallel loops use, including the calling thread.
+     */
+    inline size_t threadCount() {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 0 ? static_cast<size_t>(hardwareThreads) : 1;
+    }
+
+    /**
+     Calls the given function for every index in [0, count). The indices are distributed dynamically among the calling
+     thread and a number of worker threads in chunks of the given size. If there are fewer than minCountPerThread
+     indices per thread, fewer worker threads are used, and if there are too few indices to use any workers at all, the
+     loop runs on the calling thread only.
+
+     The function must be safe to call concurrently for different indices. If it throws an exception, the remaining
+     indices of the current chunk are skipped, the other threads run to completion, and the first exception is
+     rethrown on the calling thread.
+     */
+    template <typename F>
+    void parallelFor(const size_t count, F f, const size_t minCountPerThread = 16, const size_t chunkSize = 4) {
+        const size_t maxThreads = std::max(static_cast<size_t>(1), count / std::max(static_cast<size_t>(1), minCountPerThread));
+        const size_t threads = std::min(threadCount(), maxThreads);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i)
+                f(i);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> exceptions(threads);
+
+        auto work = [&](const size_t threadIndex) {
+            try {
+                size_t first;
+                while ((first = next.fetch_add(chunkSize)) < count) {
+                    const size_t last = std::min(first + chunkSize, count);
+                    for (size_t i = first; i < last; ++i)
+                        f(i);
+                }
+            } catch (...) {
+                exceptions[threadIndex] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (size_t i = 1; i < threads; ++i)
+            workers.push_back(std::thread(work, i));
+        work(0);
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        for (const std::exception_ptr& exception : exceptions) {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+
+    /**
+     Calls parallelFor for consecutive blocks of the given size. After each block, blockDone is called on the calling
+     thread with the number of indices processed so far, e.g. to report progress.
+     */
+    template <typename F, typename G>
+    void parallelForBlocks(const size_t count, const size_t blockSize, F f, G blockDone) {
+        const size_t size = std::max(static_cast<size_t>(1), blockSize);
+        for (size_t first = 0; first < count; first += size) {
+            const size_t last = std::min(first + size, count);
+            parallelFor(last - first, [&](const size_t i) { f(first + i); });
+            blockDone(last);
+        }
+    }
+
+    /**
+     Calls the given function for every element of the given vector, see parallelFor.
+     */
+    template <typename T, typename F>
+    void parallelForEach(std::vector<T>& elements, F f, const size_t minCountPerThread = 16, const size_t chunkSize = 4) {
+        parallelFor(elements.size(), [&](const size_t i) { f(elements[i]); }, minCountPerThread, chunkSize);
+    }
+
+    template <typename T, typename F>
+    void parallelForEach(const std::vector<T>& elements, F f, const size_t minCountPerThread = 16, const size_t chunkSize = 4) {
+        parallelFor(elements.size(), [&](const size_t i) { f(elements[i]); }, minCountPerThread, chunkSize);
+    }
+}
+
+#endif
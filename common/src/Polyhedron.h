@@ -370,6 +370,8 @@ public: // General purpose methods
     ClosestVertexSet findClosestVertices(const V& position) const;
     Edge* findEdgeByPositions(const V& pos1, const V& pos2, T epsilon = Math::Constants<T>::almostZero()) const;
     Face* findFaceByPositions(const typename V::List& positions, T epsilon = Math::Constants<T>::almostZero()) const;
+    
+    void translate(const V& delta);
 private:
     template <typename O>
     void getVertexPositions(O output) const;
@@ -432,6 +434,11 @@ private:
     Vertex* addFurtherPointToPolyhedron(const V& position, Callback& callback);
     Vertex* addPointToPolyhedron(const V& position, const Seam& seam, Callback& callback);
     
+    class ConflictTracker;
+    void addPointsWithQuickHull(const typename V::List& points, Callback& callback);
+    void addInitialSimplex(const typename V::List& points, Callback& callback);
+    Vertex* addVisiblePoint(const V& position, Face* face, Callback& callback);
+    
     void removeSingleVertex(Vertex* vertex, Callback& callback);
     void removeVertexFromEdge(Vertex* vertex, Callback& callback);
     void removeVertexFromPolygon(Vertex* vertex, Callback& callback);
@@ -445,6 +452,7 @@ private:
     class SplitByNormalCriterion;
     
     Seam createSeam(const SplittingCriterion& criterion);
+    Seam createSeam(const SplittingCriterion& criterion, Edge* first);
     
     void split(const Seam& seam, Callback& callback);
     void deleteFaces(HalfEdge* current, FaceSet& visitedFaces, VertexList& verticesToDelete, Callback& callback);
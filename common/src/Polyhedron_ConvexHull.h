@@ -20,7 +20,10 @@
 #ifndef TrenchBroom_Polyhedron_ConvexHull_h
 #define TrenchBroom_Polyhedron_ConvexHull_h
 
+#include <algorithm>
 #include <list>
+#include <map>
+#include <vector>
 
 template <typename T, typename FP, typename VP>
 class Polyhedron<T,FP,VP>::Seam {
@@ -168,14 +171,20 @@ void Polyhedron<T,FP,VP>::addPoints(const typename V::List& points, Callback& ca
 template <typename T, typename FP, typename VP> template <typename I>
 void Polyhedron<T,FP,VP>::addPoints(I cur, I end) {
     Callback c;
-    while (cur != end)
-        addPoint(*cur++, c);
+    addPoints(cur, end, c);
 }
 
 template <typename T, typename FP, typename VP> template <typename I>
 void Polyhedron<T,FP,VP>::addPoints(I cur, I end, Callback& callback) {
-    while (cur != end)
-        addPoint(*cur++, callback);
+    const typename V::List points(cur, end);
+    
+    // Adding a handful of points one by one is cheaper than setting up the conflict lists.
+    if (points.size() > 8) {
+        addPointsWithQuickHull(points, callback);
+    } else {
+        for (const V& point : points)
+            addPoint(point, callback);
+    }
 }
 
 template <typename T, typename FP, typename VP>
@@ -256,12 +265,10 @@ void Polyhedron<T,FP,VP>::merge(const Polyhedron& other) {
 template <typename T, typename FP, typename VP>
 void Polyhedron<T,FP,VP>::merge(const Polyhedron& other, Callback& callback) {
     if (!other.empty()) {
-        const Vertex* firstVertex = other.vertices().front();
-        const Vertex* currentVertex = firstVertex;
-        do {
-            addPoint(currentVertex->position(), callback);
-            currentVertex = currentVertex->next();
-        } while (currentVertex != firstVertex);
+        typename V::List points;
+        points.reserve(other.vertexCount());
+        other.getVertexPositions(std::back_inserter(points));
+        addPoints(std::begin(points), std::end(points), callback);
     }
 }
 
@@ -565,6 +572,266 @@ typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addPointToPolyhedron(
     return newVertex;
 }
 
+/**
+ Keeps track of the points which remain to be added during a bulk insertion. Every such point is assigned to one face
+ which it is above. When faces are deleted, their points are collected so that they can be reassigned to the faces
+ which replace them. Points which are not above any face are inside the polyhedron and are dropped.
+ 
+ All callbacks are forwarded to the wrapped callback.
+ */
+template <typename T, typename FP, typename VP>
+class Polyhedron<T,FP,VP>::ConflictTracker : public Polyhedron<T,FP,VP>::Callback {
+private:
+    typedef std::map<Face*, typename V::List> ConflictMap;
+    typedef std::vector<Face*> FaceVector;
+    
+    Callback& m_callback;
+    ConflictMap m_conflicts;
+    FaceVector m_pendingFaces;
+    FaceVector m_createdFaces;
+    typename V::List m_orphans;
+public:
+    ConflictTracker(Callback& callback) :
+    m_callback(callback) {}
+    
+    void assign(const V& point, const FaceVector& faces) {
+        for (Face* face : faces) {
+            if (plane(face).pointStatus(point) == Math::PointStatus::PSAbove) {
+                typename V::List& points = m_conflicts[face];
+                if (points.empty())
+                    m_pendingFaces.push_back(face);
+                points.push_back(point);
+                return;
+            }
+        }
+    }
+    
+    /**
+     Finds a face which has points assigned to it and removes the point which is farthest from that face. Returns
+     false if no points remain.
+     */
+    bool selectEyePoint(Face*& face, V& point) {
+        while (!m_pendingFaces.empty()) {
+            Face* candidate = m_pendingFaces.back();
+            m_pendingFaces.pop_back();
+            
+            typename ConflictMap::iterator it = m_conflicts.find(candidate);
+            if (it != std::end(m_conflicts) && !it->second.empty()) {
+                typename V::List& points = it->second;
+                const Plane<T,3> facePlane = plane(candidate);
+                
+                size_t farthest = 0;
+                T maxDistance = facePlane.pointDistance(points[0]);
+                for (size_t i = 1; i < points.size(); ++i) {
+                    const T distance = facePlane.pointDistance(points[i]);
+                    if (distance > maxDistance) {
+                        maxDistance = distance;
+                        farthest = i;
+                    }
+                }
+                
+                face = candidate;
+                point = points[farthest];
+                points.erase(std::begin(points) + static_cast<std::ptrdiff_t>(farthest));
+                
+                // If the face survives the insertion of the eye point, it must be considered again.
+                if (!points.empty())
+                    m_pendingFaces.push_back(candidate);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void reassignOrphans() {
+        FaceVector createdFaces;
+        typename V::List orphans;
+        
+        using std::swap;
+        swap(createdFaces, m_createdFaces);
+        swap(orphans, m_orphans);
+        
+        for (const V& point : orphans)
+            assign(point, createdFaces);
+    }
+public:
+    void vertexWasCreated(Vertex* vertex) {
+        m_callback.vertexWasCreated(vertex);
+    }
+    
+    void vertexWillBeDeleted(Vertex* vertex) {
+        m_callback.vertexWillBeDeleted(vertex);
+    }
+    
+    void vertexWasAdded(Vertex* vertex) {
+        m_callback.vertexWasAdded(vertex);
+    }
+    
+    void vertexWillBeRemoved(Vertex* vertex) {
+        m_callback.vertexWillBeRemoved(vertex);
+    }
+    
+    Plane<T,3> plane(const Face* face) const {
+        return m_callback.plane(face);
+    }
+    
+    void faceWasCreated(Face* face) {
+        m_createdFaces.push_back(face);
+        m_callback.faceWasCreated(face);
+    }
+    
+    void faceWillBeDeleted(Face* face) {
+        typename ConflictMap::iterator it = m_conflicts.find(face);
+        if (it != std::end(m_conflicts)) {
+            m_orphans.insert(std::end(m_orphans), std::begin(it->second), std::end(it->second));
+            m_conflicts.erase(it);
+        }
+        m_createdFaces.erase(std::remove(std::begin(m_createdFaces), std::end(m_createdFaces), face), std::end(m_createdFaces));
+        m_callback.faceWillBeDeleted(face);
+    }
+    
+    void faceDidChange(Face* face) {
+        m_callback.faceDidChange(face);
+    }
+    
+    void faceWasFlipped(Face* face) {
+        m_callback.faceWasFlipped(face);
+    }
+    
+    void faceWasSplit(Face* original, Face* clone) {
+        m_callback.faceWasSplit(original, clone);
+    }
+    
+    void facesWillBeMerged(Face* remaining, Face* toDelete) {
+        m_callback.facesWillBeMerged(remaining, toDelete);
+    }
+};
+
+/**
+ Adds the given points using the Quickhull algorithm. Starting from a tetrahedron spanned by extreme points, every
+ remaining point is assigned to a face which it is above. Then the farthest point of such a face is added and only the
+ points assigned to the faces removed by that insertion have to be reassigned. Points inside the polyhedron are never
+ inserted.
+ 
+ If the points are coplanar, or if this polyhedron is not empty and not yet a polyhedron, the points are added one by
+ one until this is a polyhedron.
+ */
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::addPointsWithQuickHull(const typename V::List& points, Callback& callback) {
+    if (empty())
+        addInitialSimplex(points, callback);
+    
+    typename V::List::const_iterator it = std::begin(points);
+    typename V::List::const_iterator end = std::end(points);
+    while (it != end && !polyhedron())
+        addPoint(*it++, callback);
+    
+    if (it == end)
+        return;
+    
+    ConflictTracker tracker(callback);
+    const std::vector<Face*> faces(std::begin(m_faces), std::end(m_faces));
+    while (it != end)
+        tracker.assign(*it++, faces);
+    
+    Face* face = nullptr;
+    V point;
+    while (tracker.selectEyePoint(face, point)) {
+        if (addVisiblePoint(point, face, tracker) != nullptr)
+            tracker.reassignOrphans();
+    }
+}
+
+// Adds the extreme points along the coordinate axes, the point farthest from the line through them, and the point
+// farthest from the plane through those three points.
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::addInitialSimplex(const typename V::List& points, Callback& callback) {
+    assert(empty());
+    assert(!points.empty());
+    
+    size_t extremes[6] = { 0, 0, 0, 0, 0, 0 };
+    for (size_t i = 1; i < points.size(); ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            if (points[i][j] < points[extremes[2*j]][j])
+                extremes[2*j] = i;
+            if (points[i][j] > points[extremes[2*j+1]][j])
+                extremes[2*j+1] = i;
+        }
+    }
+    
+    size_t first = 0;
+    size_t second = 0;
+    T maxDistance2 = static_cast<T>(0.0);
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = i + 1; j < 6; ++j) {
+            const T distance2 = points[extremes[i]].squaredDistanceTo(points[extremes[j]]);
+            if (distance2 > maxDistance2) {
+                maxDistance2 = distance2;
+                first = extremes[i];
+                second = extremes[j];
+            }
+        }
+    }
+    
+    addPoint(points[first], callback);
+    if (first == second)
+        return;
+    addPoint(points[second], callback);
+    
+    const V axis = (points[second] - points[first]).normalized();
+    size_t third = first;
+    maxDistance2 = static_cast<T>(0.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const T distance2 = crossed(points[i] - points[first], axis).squaredLength();
+        if (distance2 > maxDistance2) {
+            maxDistance2 = distance2;
+            third = i;
+        }
+    }
+    
+    Plane<T,3> plane;
+    if (third == first || !setPlanePoints(plane, points[first], points[second], points[third]))
+        return;
+    addPoint(points[third], callback);
+    
+    size_t fourth = first;
+    T maxDistance = static_cast<T>(0.0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const T distance = std::abs(plane.pointDistance(points[i]));
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            fourth = i;
+        }
+    }
+    
+    if (fourth != first)
+        addPoint(points[fourth], callback);
+}
+
+// Adds the given point, which is known to be above the given face, to this polyhedron. The seam is found by searching
+// the faces visible from the given point, starting at the given face, instead of examining every edge.
+template <typename T, typename FP, typename VP>
+typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addVisiblePoint(const V& position, Face* face, Callback& callback) {
+    assert(polyhedron());
+    assert(checkInvariant());
+    
+    const SplitByVisibilityCriterion criterion(position);
+    Edge* first = criterion.matches(face) ? criterion.findFirstSplittingEdge(m_edges) : criterion.findFirstSplittingEdge(face);
+    const Seam seam = createSeam(criterion, first);
+    
+    // See addFurtherPointToPolyhedron
+    if (seam.empty() || seam.hasMultipleLoops())
+        return nullptr;
+    
+    split(seam, callback);
+    Vertex* result = addPointToPolyhedron(position, seam, callback);
+    m_bounds.mergeWith(position);
+    
+    assert(checkInvariant());
+    callback.vertexWasAdded(result);
+    return result;
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T,FP,VP>::removeSingleVertex(Vertex* vertex, Callback& callback) {
     assert(point());
@@ -677,9 +944,13 @@ void Polyhedron<T,FP,VP>::removeVertexFromPolyhedron(Vertex* vertex, Callback& c
 
 template <typename T, typename FP, typename VP>
 typename Polyhedron<T,FP,VP>::Seam Polyhedron<T,FP,VP>::createSeam(const SplittingCriterion& criterion) {
+    return createSeam(criterion, criterion.findFirstSplittingEdge(m_edges));
+}
+
+template <typename T, typename FP, typename VP>
+typename Polyhedron<T,FP,VP>::Seam Polyhedron<T,FP,VP>::createSeam(const SplittingCriterion& criterion, Edge* first) {
     Seam seam;
     
-    Edge* first = criterion.findFirstSplittingEdge(m_edges);
     if (first != nullptr) {
         Edge* current = first;
         do {
@@ -1056,6 +1327,41 @@ public:
         return nullptr;
     }
     
+    // finds a seam edge by searching the faces which don't match, starting at the given face
+    Edge* findFirstSplittingEdge(Face* face) const {
+        assert(!matches(face));
+        
+        FaceSet visitedFaces;
+        std::vector<Face*> stack(1, face);
+        visitedFaces.insert(face);
+        
+        while (!stack.empty()) {
+            Face* current = stack.back();
+            stack.pop_back();
+            
+            for (HalfEdge* halfEdge : current->boundary()) {
+                Edge* edge = halfEdge->edge();
+                const MatchResult result = matches(edge);
+                switch (result) {
+                    case MatchResult_Second:
+                        edge->flip();
+                    case MatchResult_First:
+                        return edge;
+                    case MatchResult_Neither: {
+                        Face* neighbour = halfEdge->twin()->face();
+                        if (visitedFaces.insert(neighbour).second)
+                            stack.push_back(neighbour);
+                        break;
+                    }
+                    case MatchResult_Both:
+                        break;
+                    switchDefault()
+                }
+            }
+        }
+        return nullptr;
+    }
+    
     // finds the next seam edge in counter clockwise orientation
     Edge* findNextSplittingEdge(Edge* last) const {
         ensure(last != nullptr, "last is null");
@@ -21,6 +21,7 @@
 #define TrenchBroom_Polyhedron_Misc_h
 
 #include <map>
+#include <unordered_map>
 
 template <typename T, typename FP, typename VP>
 class Polyhedron<T,FP,VP>::VertexDistanceCmp {
@@ -176,7 +177,7 @@ Polyhedron<T,FP,VP>::Polyhedron(const typename V::Set& positions, Callback& call
 
 template <typename T, typename FP, typename VP>
 Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other) {
-    Copy copy(other.faces(), other.edges(), other.vertices(), *this);
+    Copy copy(other, *this);
 }
 
 template <typename T, typename FP, typename VP>
@@ -321,11 +322,10 @@ void Polyhedron<T,FP,VP>::setBounds(const BBox<T,3>& bounds, Callback& callback)
 template <typename T, typename FP, typename VP>
 class Polyhedron<T,FP,VP>::Copy {
 private:
-    typedef std::map<const Vertex*, Vertex*> VertexMap;
-    typedef typename VertexMap::value_type VertexMapEntry;
-    
-    typedef std::map<const HalfEdge*, HalfEdge*> HalfEdgeMap;
-    typedef typename HalfEdgeMap::value_type HalfEdgeMapEntry;
+    // The maps are only used to look up the copies of the original elements, so hash maps that are sized to the
+    // original polyhedron up front avoid both the rebalancing and the rehashing while copying.
+    typedef std::unordered_map<const Vertex*, Vertex*> VertexMap;
+    typedef std::unordered_map<const HalfEdge*, HalfEdge*> HalfEdgeMap;
     
     VertexMap m_vertexMap;
     HalfEdgeMap m_halfEdgeMap;
@@ -335,12 +335,15 @@ private:
     FaceList m_faces;
     Polyhedron& m_destination;
 public:
-    Copy(const FaceList& originalFaces, const EdgeList& originalEdges, const VertexList& originalVertices, Polyhedron& destination) :
+    Copy(const Polyhedron& original, Polyhedron& destination) :
     m_destination(destination) {
-        copyVertices(originalVertices);
-        copyFaces(originalFaces);
-        copyEdges(originalEdges);
-        swapContents();
+        m_vertexMap.reserve(original.vertexCount());
+        m_halfEdgeMap.reserve(2 * original.edgeCount());
+        
+        copyVertices(original.vertices());
+        copyFaces(original.faces());
+        copyEdges(original.edges());
+        swapContents(original.bounds());
     }
 private:
     void copyVertices(const VertexList& originalVertices) {
@@ -349,7 +352,7 @@ private:
             const Vertex* currentVertex = firstVertex;
             do {
                 Vertex* copy = new Vertex(currentVertex->position());
-                assertResult(MapUtils::insertOrFail(m_vertexMap, currentVertex, copy));
+                assertResult(m_vertexMap.insert(std::make_pair(currentVertex, copy)).second);
                 m_vertices.append(copy, 1);
                 currentVertex = currentVertex->next();
             } while (currentVertex != firstVertex);
@@ -430,25 +433,25 @@ private:
     }
     
     HalfEdge* findOrCopyHalfEdge(const HalfEdge* original) {
-        typedef std::pair<bool, typename HalfEdgeMap::iterator> InsertPos;
-        
-        InsertPos insertPos = MapUtils::findInsertPos(m_halfEdgeMap, original);
-        if (!insertPos.first) {
+        typename HalfEdgeMap::iterator it = m_halfEdgeMap.find(original);
+        if (it == std::end(m_halfEdgeMap)) {
             const Vertex* originalOrigin = original->origin();
             Vertex* myOrigin = findVertex(originalOrigin);
             HalfEdge* copy = new HalfEdge(myOrigin);
-            m_halfEdgeMap.insert(insertPos.second, std::make_pair(original, copy));
+            m_halfEdgeMap.insert(std::make_pair(original, copy));
             return copy;
         }
-        return insertPos.second->second;
+        return it->second;
     }
     
-    void swapContents() {
+    void swapContents(const BBox<T,3>& bounds) {
         using std::swap;
         swap(m_vertices, m_destination.m_vertices);
         swap(m_edges, m_destination.m_edges);
         swap(m_faces, m_destination.m_faces);
-        m_destination.updateBounds();
+        
+        // the copied vertices are at the same positions, so the bounds need not be recomputed
+        m_destination.m_bounds = bounds;
     }
 };
 
@@ -1083,6 +1086,21 @@ bool Polyhedron<T,FP,VP>::checkLeavingEdges(const Vertex* v) const {
     return true;
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::translate(const V& delta) {
+    if (m_vertices.empty())
+        return;
+    
+    Vertex* firstVertex = m_vertices.front();
+    Vertex* currentVertex = firstVertex;
+    do {
+        currentVertex->setPosition(currentVertex->position() + delta);
+        currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+    
+    m_bounds = m_bounds.translated(delta);
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T,FP,VP>::correctVertexPositions(const size_t decimals, const T epsilon) {
     Vertex* firstVertex = m_vertices.front();
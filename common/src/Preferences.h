@@ -35,6 +35,7 @@ namespace TrenchBroom {
         extern Preference<int> MapViewLayout;
         
         extern Preference<bool>  ShowAxes;
+        extern Preference<bool>  ShowRenderProfile;
         extern Preference<Color> BackgroundColor;
         extern Preference<float> AxisLength;
         extern Preference<Color> XAxisColor;
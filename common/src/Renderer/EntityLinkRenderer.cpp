@@ -24,6 +24,7 @@
 #include "Model/CollectMatchingNodesVisitor.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
+#include "Model/ModelUtils.h"
 #include "Model/NodeVisitor.h"
 #include "Model/World.h"
 #include "Renderer/Camera.h"
@@ -65,6 +66,36 @@ namespace TrenchBroom {
             m_valid = false;
         }
 
+        static bool hasLinks(const Model::AttributableNode* node) {
+            return (!node->linkSources().empty() || !node->linkTargets().empty() ||
+                    !node->killSources().empty() || !node->killTargets().empty());
+        }
+        
+        class EntityLinkRenderer::MatchLinkedNodes {
+        public:
+            // changing the attributes of an entity may remove its links, so entities are always matched
+            bool operator()(const Model::World* world) const   { return true; }
+            bool operator()(const Model::Layer* layer) const   { return false; }
+            bool operator()(const Model::Group* group) const   { return false; }
+            bool operator()(const Model::Entity* entity) const { return true; }
+            bool operator()(const Model::Brush* brush) const   {
+                // the links of a brush entity are anchored at its bounds
+                const Model::AttributableNode* entity = brush->entity();
+                return entity != NULL && hasLinks(entity);
+            }
+        };
+
+        void EntityLinkRenderer::nodesDidChange(const Model::NodeList& nodes) {
+            if (!m_valid)
+                return;
+            
+            // edits of brushes that do not belong to a linked entity, which are the most common ones, keep the links
+            Model::CollectMatchingNodesVisitor<MatchLinkedNodes> visitor;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            if (!visitor.nodes().empty())
+                invalidate();
+        }
+
         void EntityLinkRenderer::doPrepareVertices(Vbo& vertexVbo) {
             if (!m_valid) {
                 validate();
@@ -161,38 +192,31 @@ namespace TrenchBroom {
         
         class EntityLinkRenderer::CollectTransitiveSelectedLinksVisitor : public CollectLinksVisitor {
         private:
-            Model::NodeSet m_visited;
+            Model::AttributableNodeList m_selectedEntities;
         public:
             CollectTransitiveSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
             CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
-        private:
-            void visitEntity(Model::Entity* entity) {
-                if (m_editorContext.visible(entity)) {
-                    const bool visited = !m_visited.insert(entity).second;
-                    if (!visited) {
-                        addSources(entity->linkSources(), entity);
-                        addSources(entity->killSources(), entity);
-                        addTargets(entity, entity->linkTargets());
-                        addTargets(entity, entity->killTargets());
-                    }
+            
+            void addLinks() {
+                const Model::AttributableNodeList nodes = Model::collectLinkedNodes(m_selectedEntities, [this](const Model::AttributableNode* node) {
+                    return m_editorContext.visible(node);
+                });
+                
+                // every visible target of these nodes is one of them, so each link is added once, by its source
+                for (const Model::AttributableNode* node : nodes) {
+                    addTargets(node, node->linkTargets());
+                    addTargets(node, node->killTargets());
                 }
             }
-
-            void addSources(const Model::AttributableNodeList& sources, Model::Entity* target) {
-                for (Model::AttributableNode* source : sources) {
-                    if (m_editorContext.visible(source)) {
-                        addLink(source, target);
-                        source->accept(*this);
-                    }
-                }
+        private:
+            void visitEntity(Model::Entity* entity) {
+                m_selectedEntities.push_back(entity);
             }
             
-            void addTargets(Model::Entity* source, const Model::AttributableNodeList& targets) {
-                for (Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target)) {
+            void addTargets(const Model::AttributableNode* source, const Model::AttributableNodeList& targets) {
+                for (const Model::AttributableNode* target : targets) {
+                    if (m_editorContext.visible(target))
                         addLink(source, target);
-                        target->accept(*this);
-                    }
                 }
             }
         };
@@ -262,6 +286,7 @@ namespace TrenchBroom {
             
             CollectTransitiveSelectedLinksVisitor visitor(editorContext, m_defaultColor, m_selectedColor, links);
             collectSelectedLinks(visitor);
+            visitor.addLinks();
         }
         
         void EntityLinkRenderer::getDirectSelectedLinks(Vertex::List& links) const {
@@ -55,6 +55,11 @@ namespace TrenchBroom {
             
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+            
+            /**
+             Invalidates this renderer if any of the given changed nodes can affect the rendered links.
+             */
+            void nodesDidChange(const Model::NodeList& nodes);
         private:
             void doPrepareVertices(Vbo& vertexVbo);
             void doRender(RenderContext& renderContext);
@@ -63,6 +68,7 @@ namespace TrenchBroom {
             
             class MatchEntities;
             class CollectEntitiesVisitor;
+            class MatchLinkedNodes;
             
             class CollectLinksVisitor;
             class CollectAllLinksVisitor;
@@ -119,6 +119,11 @@ namespace TrenchBroom {
     Func4<void, GLenum, GLsizei, GLenum, const GLvoid*> glDrawElements;
     Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*> glDrawRangeElements;
     Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei> glMultiDrawElements;
+
+    Func2<void, GLsizei, GLuint*> glGenQueries;
+    Func2<void, GLsizei, const GLuint*> glDeleteQueries;
+    Func2<void, GLuint, GLenum> glQueryCounter;
+    Func3<void, GLuint, GLenum, GLuint64*> glGetQueryObjectui64v;
     
     Func1<GLuint, GLenum> glCreateShader;
     Func1<void, GLuint> glDeleteShader;
@@ -25,6 +25,7 @@
 #include "StringUtils.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace TrenchBroom {
@@ -110,6 +111,7 @@ namespace TrenchBroom {
 #define GL_RGB 0x1907
 #define GL_RGBA 0x1908
 #define GL_BGR 0x80E0
+#define GL_BGRA 0x80E1
 #define GL_LUMINANCE 0x1909
 #define GL_LUMINANCE_ALPHA 0x190A
 
@@ -165,6 +167,11 @@ namespace TrenchBroom {
 #define GL_DYNAMIC_READ 0x88E9
 #define GL_DYNAMIC_COPY 0x88EA
 
+#define GL_EXTENSIONS 0x1F03
+
+#define GL_QUERY_RESULT 0x8866
+#define GL_TIMESTAMP 0x8E28
+
 #define GL_FRAGMENT_SHADER 0x8B30
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_COMPILE_STATUS 0x8B81
@@ -186,6 +193,7 @@ namespace TrenchBroom {
     typedef unsigned short GLushort;
     typedef unsigned int GLuint;
     typedef unsigned long GLulong;
+    typedef uint64_t GLuint64;
     
     typedef float GLfloat;
     typedef double GLdouble;
@@ -308,6 +316,11 @@ namespace TrenchBroom {
     extern Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*> glDrawRangeElements;
     extern Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei> glMultiDrawElements;
 
+    extern Func2<void, GLsizei, GLuint*> glGenQueries;
+    extern Func2<void, GLsizei, const GLuint*> glDeleteQueries;
+    extern Func2<void, GLuint, GLenum> glQueryCounter;
+    extern Func3<void, GLuint, GLenum, GLuint64*> glGetQueryObjectui64v;
+
     extern Func1<GLuint, GLenum> glCreateShader;
     extern Func1<void, GLuint> glDeleteShader;
     extern Func4<void, GLuint, GLsizei, const GLchar**, const GLint*> glShaderSource;
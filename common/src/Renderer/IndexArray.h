@@ -23,6 +23,7 @@
 #include "CollectionUtils.h"
 #include "SharedPointer.h"
 #include "Renderer/GL.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Vbo.h"
 #include "Renderer/VboBlock.h"
 
@@ -100,6 +101,7 @@ namespace TrenchBroom {
                     const GLvoid* renderOffset = reinterpret_cast<GLvoid*>(indexOffset() + sizeof(Index) * offset);
 
                     glAssert(glDrawElements(primType, renderCount, indexType, renderOffset));
+                    RenderProfiler::countDrawCall();
                 }
             private:
                 virtual const IndexList& doGetIndices() const = 0;
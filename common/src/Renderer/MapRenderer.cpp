@@ -40,6 +40,7 @@
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderService.h"
 #include "Renderer/RenderUtils.h"
 #include "View/Selection.h"
@@ -205,17 +206,27 @@ namespace TrenchBroom {
         }
         
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
-            commitPendingChanges();
+            {
+                ProfileSection section(renderContext, "Commit changes");
+                commitPendingChanges();
+            }
             setupGL(renderBatch);
-            renderDefaultOpaque(renderContext, renderBatch);
-            renderLockedOpaque(renderContext, renderBatch);
-            renderSelectionOpaque(renderContext, renderBatch);
-            
-            renderDefaultTransparent(renderContext, renderBatch);
-            renderLockedTransparent(renderContext, renderBatch);
-            renderSelectionTransparent(renderContext, renderBatch);
-            
-            renderEntityLinks(renderContext, renderBatch);
+            {
+                ProfileSection section(renderContext, "Opaque");
+                renderDefaultOpaque(renderContext, renderBatch);
+                renderLockedOpaque(renderContext, renderBatch);
+                renderSelectionOpaque(renderContext, renderBatch);
+            }
+            {
+                ProfileSection section(renderContext, "Transparent");
+                renderDefaultTransparent(renderContext, renderBatch);
+                renderLockedTransparent(renderContext, renderBatch);
+                renderSelectionTransparent(renderContext, renderBatch);
+            }
+            {
+                ProfileSection section(renderContext, "Entity links");
+                renderEntityLinks(renderContext, renderBatch);
+            }
             renderTutorialMessages(renderContext, renderBatch);
         }
         
@@ -556,7 +567,7 @@ namespace TrenchBroom {
         
         void MapRenderer::nodesDidChange(const Model::NodeList& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->nodesDidChange(nodes);
         }
         
         void MapRenderer::nodeVisibilityDidChange(const Model::NodeList& nodes) {
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Vbo.h"
 
 namespace TrenchBroom {
@@ -93,11 +94,22 @@ namespace TrenchBroom {
             m_oneshots.push_back(renderable);
         }
         
+        void RenderBatch::prepare() {
+            ActivateVbo activate(m_vertexVbo);
+            prepareRenderables();
+        }
+
         void RenderBatch::render(RenderContext& renderContext) {
             ActivateVbo activate(m_vertexVbo);
 
-            prepareRenderables();
-            renderRenderables(renderContext);
+            {
+                ProfileSection section(renderContext, "Upload");
+                prepareRenderables();
+            }
+            {
+                ProfileSection section(renderContext, "Draw");
+                renderRenderables(renderContext);
+            }
         }
 
         void RenderBatch::doAdd(Renderable* renderable) {
@@ -62,6 +62,11 @@ namespace TrenchBroom {
             void addOneShot(DirectRenderable* renderable);
             void addOneShot(IndexedRenderable* renderable);
             
+            /**
+             Uploads the vertices and indices of the renderables in this batch. Rendering the batch does this anyway,
+             so this is only needed to upload a batch without rendering it.
+             */
+            void prepare();
             void render(RenderContext& renderContext);
         private:
             void doAdd(Renderable* renderable);
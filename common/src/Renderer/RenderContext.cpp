@@ -29,6 +29,7 @@ namespace TrenchBroom {
         m_transformation(m_camera.projectionMatrix(), m_camera.viewMatrix()),
         m_fontManager(fontManager),
         m_shaderManager(shaderManager),
+        m_profiler(NULL),
         m_showTextures(true),
         m_showFaces(true),
         m_showEdges(true),
@@ -68,6 +69,14 @@ namespace TrenchBroom {
             return m_shaderManager;
         }
 
+        RenderProfiler* RenderContext::profiler() {
+            return m_profiler;
+        }
+
+        void RenderContext::setProfiler(RenderProfiler* profiler) {
+            m_profiler = profiler;
+        }
+
         bool RenderContext::showTextures() const {
             return m_showTextures;
         }
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         class Camera;
         class FontManager;
         class Renderable;
+        class RenderProfiler;
         class ShaderManager;
         
         class RenderContext {
@@ -54,6 +55,7 @@ namespace TrenchBroom {
             Transformation m_transformation;
             FontManager& m_fontManager;
             ShaderManager& m_shaderManager;
+            RenderProfiler* m_profiler;
 
             // settings for any map rendering view
             bool m_showTextures;
@@ -85,6 +87,12 @@ namespace TrenchBroom {
             Transformation& transformation();
             FontManager& fontManager();
             ShaderManager& shaderManager();
+
+            /**
+             Returns the profiler that records the passes of this frame, or NULL if the frame is not profiled.
+             */
+            RenderProfiler* profiler();
+            void setProfiler(RenderProfiler* profiler);
             
             bool showTextures() const;
             void setShowTextures(bool showTextures);
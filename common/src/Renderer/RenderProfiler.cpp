@@ -0,0 +1,281 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderProfiler.h"
+
+#include "Renderer/RenderContext.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        RenderProfiler::Section::Section(const String& i_name, const size_t i_depth) :
+        name(i_name),
+        depth(i_depth),
+        cpuTime(0.0),
+        gpuTime(std::numeric_limits<double>::quiet_NaN()),
+        drawCalls(0),
+        uploadBytes(0) {}
+
+        RenderProfiler::Frame::Frame() :
+        number(0) {}
+
+        RenderProfiler::Frame::Frame(const String& i_view, const size_t i_number) :
+        view(i_view),
+        number(i_number) {}
+
+        const size_t RenderProfiler::MaxFrameCount = 1000;
+
+        RenderProfiler::ViewState::ViewState() :
+        pending(false) {}
+
+        RenderProfiler::RenderProfiler() :
+        m_enabled(false),
+        m_gpuTimers(GpuTimers_Unknown),
+        m_frameCount(0),
+        m_inFrame(false),
+        m_currentViewState(NULL) {}
+
+        bool RenderProfiler::enabled() const {
+            return m_enabled;
+        }
+
+        void RenderProfiler::setEnabled(const bool enabled) {
+            assert(!m_inFrame);
+            if (enabled == m_enabled)
+                return;
+            m_enabled = enabled;
+
+            // a pending frame would be recorded much later, so its timings would be stale
+            if (!m_enabled) {
+                for (auto& entry : m_viewStates)
+                    discardPendingFrame(entry.second);
+            }
+        }
+
+        void RenderProfiler::beginFrame(const void* view, const String& name) {
+            assert(!m_inFrame);
+            if (!m_enabled)
+                return;
+
+            m_inFrame = true;
+            m_currentViewState = &m_viewStates[view];
+            m_currentFrame = Frame(name, m_frameCount++);
+            m_currentQueries.clear();
+            m_openSections.clear();
+            beginSection("Frame");
+        }
+
+        void RenderProfiler::endFrame() {
+            if (!m_inFrame)
+                return;
+
+            while (!m_openSections.empty())
+                endSection();
+            m_inFrame = false;
+
+            ViewState& state = *m_currentViewState;
+            m_currentViewState = NULL;
+
+            resolvePendingFrame(state);
+            std::swap(state.pendingFrame, m_currentFrame);
+            state.pendingQueries.swap(m_currentQueries);
+            state.pending = true;
+        }
+
+        void RenderProfiler::releaseView(const void* view, const bool contextCurrent) {
+            assert(!m_inFrame);
+            ViewStateMap::iterator it = m_viewStates.find(view);
+            if (it == std::end(m_viewStates))
+                return;
+
+            ViewState& state = it->second;
+            discardPendingFrame(state);
+            if (contextCurrent && !state.freeQueries.empty())
+                glAssert(glDeleteQueries(static_cast<GLsizei>(state.freeQueries.size()), &state.freeQueries.front()));
+            m_viewStates.erase(it);
+        }
+
+        void RenderProfiler::beginSection(const char* name) {
+            if (!m_inFrame)
+                return;
+
+            OpenSection section;
+            section.index = m_currentFrame.sections.size();
+            section.drawCalls = drawCallCount();
+            section.uploadBytes = uploadByteCount();
+
+            m_currentFrame.sections.push_back(Section(name, m_openSections.size()));
+            m_currentQueries.push_back(queryTimestamp());
+            m_currentQueries.push_back(0);
+
+            section.start = Clock::now();
+            m_openSections.push_back(section);
+        }
+
+        void RenderProfiler::endSection() {
+            if (!m_inFrame || m_openSections.empty())
+                return;
+
+            const OpenSection open = m_openSections.back();
+            m_openSections.pop_back();
+
+            Section& section = m_currentFrame.sections[open.index];
+            section.cpuTime = std::chrono::duration<double, std::milli>(Clock::now() - open.start).count();
+            section.drawCalls = drawCallCount() - open.drawCalls;
+            section.uploadBytes = uploadByteCount() - open.uploadBytes;
+            m_currentQueries[2 * open.index + 1] = queryTimestamp();
+        }
+
+        const RenderProfiler::Frame* RenderProfiler::lastFrame(const String& view) const {
+            for (auto it = m_frames.rbegin(), end = m_frames.rend(); it != end; ++it) {
+                if (it->view == view)
+                    return &*it;
+            }
+            return NULL;
+        }
+
+        const RenderProfiler::FrameList& RenderProfiler::frames() const {
+            return m_frames;
+        }
+
+        void RenderProfiler::clear() {
+            m_frames.clear();
+        }
+
+        void RenderProfiler::writeCsv(std::ostream& str) const {
+            str << "frame,view,section,depth,cpu_ms,gpu_ms,draw_calls,upload_bytes" << std::endl;
+            for (const Frame& frame : m_frames) {
+                StringList path;
+                for (const Section& section : frame.sections) {
+                    path.resize(section.depth);
+                    path.push_back(section.name);
+
+                    str << frame.number << ","
+                        << frame.view << ","
+                        << StringUtils::join(path, "/") << ","
+                        << section.depth << ","
+                        << section.cpuTime << ",";
+                    if (!std::isnan(section.gpuTime))
+                        str << section.gpuTime;
+                    str << ","
+                        << section.drawCalls << ","
+                        << section.uploadBytes << std::endl;
+                }
+            }
+        }
+
+        void RenderProfiler::countDrawCall() {
+            ++drawCallCount();
+        }
+
+        void RenderProfiler::countUpload(const size_t bytes) {
+            uploadByteCount() += bytes;
+        }
+
+        size_t& RenderProfiler::drawCallCount() {
+            static size_t count = 0;
+            return count;
+        }
+
+        size_t& RenderProfiler::uploadByteCount() {
+            static size_t count = 0;
+            return count;
+        }
+
+        bool RenderProfiler::gpuTimersAvailable() {
+            if (m_gpuTimers == GpuTimers_Unknown) {
+                const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+                if (extensions != NULL && std::strstr(extensions, "GL_ARB_timer_query") != NULL)
+                    m_gpuTimers = GpuTimers_Available;
+                else
+                    m_gpuTimers = GpuTimers_Unavailable;
+            }
+            return m_gpuTimers == GpuTimers_Available;
+        }
+
+        GLuint RenderProfiler::queryTimestamp() {
+            if (!gpuTimersAvailable())
+                return 0;
+
+            QueryList& freeQueries = m_currentViewState->freeQueries;
+            GLuint query = 0;
+            if (freeQueries.empty()) {
+                glAssert(glGenQueries(1, &query));
+            } else {
+                query = freeQueries.back();
+                freeQueries.pop_back();
+            }
+            glAssert(glQueryCounter(query, GL_TIMESTAMP));
+            return query;
+        }
+
+        void RenderProfiler::resolvePendingFrame(ViewState& state) {
+            if (!state.pending)
+                return;
+
+            SectionList& sections = state.pendingFrame.sections;
+            for (size_t i = 0; i < sections.size(); ++i) {
+                const GLuint beginQuery = state.pendingQueries[2 * i];
+                const GLuint endQuery = state.pendingQueries[2 * i + 1];
+                if (beginQuery != 0 && endQuery != 0) {
+                    GLuint64 begin, end;
+                    glAssert(glGetQueryObjectui64v(beginQuery, GL_QUERY_RESULT, &begin));
+                    glAssert(glGetQueryObjectui64v(endQuery, GL_QUERY_RESULT, &end));
+                    sections[i].gpuTime = static_cast<double>(end - begin) / 1000000.0;
+                }
+            }
+
+            recordFrame(state.pendingFrame);
+            discardPendingFrame(state);
+        }
+
+        void RenderProfiler::discardPendingFrame(ViewState& state) {
+            for (const GLuint query : state.pendingQueries) {
+                if (query != 0)
+                    state.freeQueries.push_back(query);
+            }
+            state.pendingQueries.clear();
+            state.pendingFrame = Frame();
+            state.pending = false;
+        }
+
+        void RenderProfiler::recordFrame(const Frame& frame) {
+            m_frames.push_back(frame);
+            if (m_frames.size() > MaxFrameCount)
+                m_frames.pop_front();
+        }
+
+        ProfileSection::ProfileSection(RenderContext& renderContext, const char* name) :
+        m_profiler(renderContext.profiler()) {
+            if (m_profiler != NULL)
+                m_profiler->beginSection(name);
+        }
+
+        ProfileSection::~ProfileSection() {
+            if (m_profiler != NULL)
+                m_profiler->endSection();
+        }
+    }
+}
@@ -0,0 +1,182 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_RenderProfiler
+#define TrenchBroom_RenderProfiler
+
+#include "StringUtils.h"
+#include "Renderer/GL.h"
+
+#include <chrono>
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class RenderContext;
+
+        /**
+         Records how long the passes of a frame take and how much work they submit to OpenGL. A pass is profiled by
+         creating a ProfileSection, and sections can be nested. CPU times are measured with a steady clock. If the
+         driver supports timer queries, GPU times are measured with timestamps, which are read when the next frame of
+         the same view ends. Therefore, a frame is only recorded once the following frame has been rendered.
+
+         Views are identified by their instance rather than by their name because the timer queries belong to the
+         OpenGL context of the view. A view must be released when it is destroyed.
+
+         Draw calls and uploads are counted globally by the code that submits them. The profiler must only be used on
+         the rendering thread.
+         */
+        class RenderProfiler {
+        public:
+            struct Section {
+                String name;
+                size_t depth;
+                double cpuTime;
+                double gpuTime;
+                size_t drawCalls;
+                size_t uploadBytes;
+
+                Section(const String& i_name, size_t i_depth);
+            };
+            typedef std::vector<Section> SectionList;
+
+            struct Frame {
+                String view;
+                size_t number;
+                SectionList sections;
+
+                Frame();
+                Frame(const String& i_view, size_t i_number);
+            };
+            typedef std::deque<Frame> FrameList;
+
+            static const size_t MaxFrameCount;
+        private:
+            typedef std::chrono::steady_clock Clock;
+            typedef std::vector<GLuint> QueryList;
+
+            struct OpenSection {
+                size_t index;
+                Clock::time_point start;
+                size_t drawCalls;
+                size_t uploadBytes;
+            };
+            typedef std::vector<OpenSection> OpenSectionList;
+
+            // Query objects are not shared between contexts, so each view keeps its own until it is released.
+            struct ViewState {
+                Frame pendingFrame;
+                QueryList pendingQueries;
+                QueryList freeQueries;
+                bool pending;
+
+                ViewState();
+            };
+            typedef std::map<const void*, ViewState> ViewStateMap;
+
+            typedef enum {
+                GpuTimers_Unknown,
+                GpuTimers_Available,
+                GpuTimers_Unavailable
+            } GpuTimers;
+
+            bool m_enabled;
+            GpuTimers m_gpuTimers;
+            size_t m_frameCount;
+
+            bool m_inFrame;
+            ViewState* m_currentViewState;
+            Frame m_currentFrame;
+            QueryList m_currentQueries;
+            OpenSectionList m_openSections;
+
+            ViewStateMap m_viewStates;
+            FrameList m_frames;
+        public:
+            RenderProfiler();
+
+            bool enabled() const;
+            void setEnabled(bool enabled);
+
+            void beginFrame(const void* view, const String& name);
+            void endFrame();
+
+            /**
+             Drops the state of the given view, including its pending frame. If the context of the view is current,
+             its query objects are deleted, otherwise they are left to be released with the context.
+             */
+            void releaseView(const void* view, bool contextCurrent);
+
+            void beginSection(const char* name);
+            void endSection();
+
+            /**
+             Returns the most recent recorded frame of the given view, or NULL if there is none.
+             */
+            const Frame* lastFrame(const String& view) const;
+
+            /**
+             Returns the recorded frames, oldest first. At most MaxFrameCount frames are kept.
+             */
+            const FrameList& frames() const;
+            void clear();
+
+            /**
+             Writes the recorded frames as comma separated values with one row per section. Sections are identified by
+             their path, e.g. "Map/Opaque".
+             */
+            void writeCsv(std::ostream& str) const;
+
+            static void countDrawCall();
+            static void countUpload(size_t bytes);
+        private:
+            static size_t& drawCallCount();
+            static size_t& uploadByteCount();
+
+            bool gpuTimersAvailable();
+            GLuint queryTimestamp();
+            void resolvePendingFrame(ViewState& state);
+            void discardPendingFrame(ViewState& state);
+            void recordFrame(const Frame& frame);
+        private:
+            RenderProfiler(const RenderProfiler& other);
+            RenderProfiler& operator=(const RenderProfiler& other);
+        };
+
+        /**
+         Profiles the enclosing scope as a section of the current frame if the given render context has an enabled
+         profiler.
+         */
+        class ProfileSection {
+        private:
+            RenderProfiler* m_profiler;
+        public:
+            ProfileSection(RenderContext& renderContext, const char* name);
+            ~ProfileSection();
+        private:
+            ProfileSection(const ProfileSection& other);
+            ProfileSection& operator=(const ProfileSection& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_RenderProfiler) */
@@ -20,6 +20,7 @@
 #include "Vbo.h"
 
 #include "Exceptions.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/VboBlock.h"
 
 #include <algorithm>
@@ -47,6 +48,11 @@ namespace TrenchBroom {
 
         const float Vbo::GrowthFactor = 1.5f;
 
+        static size_t& totalVboCapacity() {
+            static size_t capacity = 0;
+            return capacity;
+        }
+
         Vbo::Vbo(const size_t initialCapacity, const GLenum type, const GLenum usage) :
         m_totalCapacity(initialCapacity),
         m_freeCapacity(m_totalCapacity),
@@ -58,6 +64,7 @@ namespace TrenchBroom {
         m_vboId(0) {
             m_lastBlock = m_firstBlock = new VboBlock(*this, 0, m_totalCapacity, NULL, NULL);
             m_freeBlocks.push_back(m_firstBlock);
+            totalVboCapacity() += m_totalCapacity;
             assert(checkBlockChain());
         }
         
@@ -65,6 +72,7 @@ namespace TrenchBroom {
             if (active())
                 deactivate();
             free();
+            totalVboCapacity() -= m_totalCapacity;
             
             VboBlock* block = m_firstBlock;
             while (block != NULL) {
@@ -76,6 +84,10 @@ namespace TrenchBroom {
             m_lastBlock = m_firstBlock = NULL;
         }
         
+        size_t Vbo::totalCapacity() {
+            return totalVboCapacity();
+        }
+
         VboBlock* Vbo::allocateBlock(const size_t capacity) {
             assert(checkBlockChain());
 
@@ -216,6 +228,7 @@ namespace TrenchBroom {
             
             m_totalCapacity += delta;
             m_freeCapacity += delta;
+            totalVboCapacity() += delta;
             assert(checkBlockChain());
             
             if (begin < end) {
@@ -232,6 +245,7 @@ namespace TrenchBroom {
                 
                 memcpy(buffer + begin, temp, end - begin);
                 delete [] temp;
+                RenderProfiler::countUpload(end - begin);
                 
                 unmap();
             } else {
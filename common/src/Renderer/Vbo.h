@@ -77,6 +77,11 @@ namespace TrenchBroom {
             
             VboBlock* allocateBlock(const size_t capacity);
 
+            /**
+             Returns the sum of the capacities of all existing VBOs in bytes. Must be called on the rendering thread.
+             */
+            static size_t totalCapacity();
+
             bool active() const;
             void activate();
             void deactivate();
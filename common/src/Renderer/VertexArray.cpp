@@ -19,6 +19,8 @@
 
 #include "VertexArray.h"
 
+#include "Renderer/RenderProfiler.h"
+
 #include <cassert>
 #include <limits>
 
@@ -97,10 +99,12 @@ namespace TrenchBroom {
             if (!m_setup) {
                 if (setup()) {
                     glAssert(glDrawArrays(primType, index, count));
+                    RenderProfiler::countDrawCall();
                     cleanup();
                 }
             } else {
                 glAssert(glDrawArrays(primType, index, count));
+                RenderProfiler::countDrawCall();
             }
         }
 
@@ -111,12 +115,14 @@ namespace TrenchBroom {
                     const GLint* indexArray   = indices.data();
                     const GLsizei* countArray = counts.data();
                     glAssert(glMultiDrawArrays(primType, indexArray, countArray, primCount));
+                    RenderProfiler::countDrawCall();
                     cleanup();
                 }
             } else {
                 const GLint* indexArray   = indices.data();
                 const GLsizei* countArray = counts.data();
                 glAssert(glMultiDrawArrays(primType, indexArray, countArray, primCount));
+                RenderProfiler::countDrawCall();
             }
             
         }
@@ -127,11 +133,13 @@ namespace TrenchBroom {
                 if (setup()) {
                     const GLint* indexArray = indices.data();
                     glAssert(glDrawElements(primType, count, GL_UNSIGNED_INT, indexArray));
+                    RenderProfiler::countDrawCall();
                     cleanup();
                 }
             } else {
                 const GLint* indexArray = indices.data();
                 glAssert(glDrawElements(primType, count, GL_UNSIGNED_INT, indexArray));
+                RenderProfiler::countDrawCall();
             }
         }
 
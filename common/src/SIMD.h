@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_SIMD_h
+#define TrenchBroom_SIMD_h
+
+// Selects the SIMD instruction sets used by the math kernels at compile time. SSE2 is part of every x86-64 target,
+// AVX is only used if the compiler was instructed to generate it (e.g. -mavx or /arch:AVX). Define TB_NO_SIMD to
+// force the scalar code paths everywhere.
+
+#if !defined(TB_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TB_SIMD_SSE2 1
+#endif
+
+#if defined(TB_SIMD_SSE2) && defined(__AVX__)
+#define TB_SIMD_AVX 1
+#endif
+#endif
+
+#if defined(TB_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(TB_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_StringPool_h
+#define TrenchBroom_StringPool_h
+
+#include "StringUtils.h"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace TrenchBroom {
+    /**
+     A set of strings that hands out references to its elements. The references stay valid for the lifetime of the
+     pool, so equal strings can share their memory and be compared by address. Strings are never removed from the
+     pool. The pool can be used from several threads at once.
+     */
+    class StringPool {
+    private:
+        std::unordered_set<String> m_strings;
+        mutable std::mutex m_mutex;
+    public:
+        /**
+         Returns the element of this pool that is equal to the given string, adding it if necessary.
+         */
+        const String& intern(const String& str);
+        size_t size() const;
+    };
+}
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <clocale>
 #include <fstream>
+#include <iostream>
 
 #include "GLInit.h"
 #include "Macros.h"
@@ -561,6 +562,7 @@ namespace TrenchBroom {
             static const wxCmdLineEntryDesc cmdLineDesc[] =
             {
                 { wxCMD_LINE_PARAM,  NULL, NULL, "input file", wxCMD_LINE_VAL_STRING, useSDI() ? wxCMD_LINE_PARAM_OPTIONAL : (wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE) },
+                { wxCMD_LINE_SWITCH, NULL, "memory-statistics", "print the memory statistics of each loaded document", wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
                 { wxCMD_LINE_NONE, NULL, NULL, NULL, wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL }
             };
 
@@ -570,13 +572,13 @@ namespace TrenchBroom {
 
         bool TrenchBroomApp::OnCmdLineParsed(wxCmdLineParser& parser) {
             if (parser.GetParamCount() > 0) {
-                if (useSDI()) {
-                    const wxString param = parser.GetParam(0);
-                    openDocument(param.ToStdString());
-                } else {
-                    for (size_t i = 0; i < parser.GetParamCount(); ++i) {
-                        const wxString param = parser.GetParam(i);
-                        openDocument(param.ToStdString());
+                const bool printMemoryStatistics = parser.Found("memory-statistics");
+                const size_t count = useSDI() ? 1 : parser.GetParamCount();
+                for (size_t i = 0; i < count; ++i) {
+                    const wxString param = parser.GetParam(i);
+                    if (openDocument(param.ToStdString()) && printMemoryStatistics) {
+                        MapDocumentSPtr document = m_frameManager->topFrame()->document();
+                        std::cout << param.ToStdString() << std::endl << document->memoryStatistics() << std::endl;
                     }
                 }
             } else {
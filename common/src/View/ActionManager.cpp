@@ -275,6 +275,9 @@ namespace TrenchBroom {
 #ifndef NDEBUG
             Menu* debugMenu = m_menuBar->addMenu("Debug");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugPrintVertices, "Print Vertices");
+            debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugPrintMemoryStatistics, "Print Memory Statistics");
+            debugMenu->addUnmodifiableCheckItem(CommandIds::Menu::DebugToggleRenderProfile, "Show Render Profile");
+            debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugExportRenderProfile, "Export Render Profile...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCreateBrush, "Create Brush...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCreateCube, "Create Cube...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugClipWithFace, "Clip Brush...");
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -113,5 +114,12 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+        
+        size_t AddRemoveNodesCommand::doGetMemoryUsage() const {
+            // the nodes to add are detached from the document and owned by this command
+            return (sizeof(AddRemoveNodesCommand) +
+                    Model::estimateMemoryUsage(m_nodesToAdd) +
+                    Model::estimateReferenceMemoryUsage(m_nodesToRemove));
+        }
     }
 }
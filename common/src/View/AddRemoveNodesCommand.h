@@ -54,6 +54,7 @@ namespace TrenchBroom {
             bool doIsRepeatable(MapDocumentCommandFacade* document) const;
             
             bool doCollateWith(UndoableCommand::Ptr command);
+            size_t doGetMemoryUsage() const;
         };
     }
 }
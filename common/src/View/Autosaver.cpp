@@ -19,18 +19,24 @@
 
 #include "Autosaver.h"
 
+#include "NotificationQueue.h"
 #include "StringUtils.h"
-#include "SetAny.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/IOUtils.h"
 #include "View/MapDocument.h"
 
+#include <wx/app.h>
+
 #include <cassert>
+#include <chrono>
+#include <functional>
 
 namespace TrenchBroom {
     namespace View {
-        Autosaver::Autosaver(View::MapDocumentWPtr document, const time_t saveInterval, const time_t idleInterval, const size_t maxBackups) :
+        Autosaver::Autosaver(View::MapDocumentWPtr document, NotificationQueue& notificationQueue, const time_t saveInterval, const time_t idleInterval, const size_t maxBackups, WriteFile writeFile) :
         m_document(document),
-        m_logger(NULL),
+        m_notificationQueue(notificationQueue),
+        m_writeFile(writeFile),
         m_saveInterval(saveInterval),
         m_idleInterval(idleInterval),
         m_maxBackups(maxBackups),
@@ -41,11 +47,19 @@ namespace TrenchBroom {
         }
         
         Autosaver::~Autosaver() {
-            unbindObservers();
-            triggerAutosave(NULL);
+            // the last backup is a courtesy, so a failure to write it must not escape the destructor
+            try {
+                unbindObservers();
+                finishPendingBackup(true);
+                triggerAutosave();
+                finishPendingBackup(true);
+            } catch (...) {}
         }
         
-        void Autosaver::triggerAutosave(Logger* logger) {
+        void Autosaver::triggerAutosave() {
+            if (!finishPendingBackup(false))
+                return;
+            
             const time_t currentTime = time(NULL);
             
             MapDocumentSPtr document = lock(m_document);
@@ -64,14 +78,34 @@ namespace TrenchBroom {
             if (!IO::Disk::fileExists(IO::Disk::fixPath(document->path())))
                 return;
             
-            SetAny<Logger*> setLogger(m_logger, logger);
             autosave(document);
         }
         
+        /**
+         Returns whether there is no backup being written anymore, waiting for it to finish if requested.
+         */
+        bool Autosaver::finishPendingBackup(const bool wait) {
+            if (!m_pendingBackup.valid())
+                return true;
+            if (!wait && m_pendingBackup.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            
+            m_pendingBackup.get();
+            return true;
+        }
+        
         void Autosaver::autosave(MapDocumentSPtr document) {
             const IO::Path& mapPath = document->path();
             assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
             
+            m_lastSaveTime = time(NULL);
+            m_lastModificationCount = document->modificationCount();
+            
+            String contents = document->serializeDocument();
+            m_pendingBackup = std::async(std::launch::async, &Autosaver::writeBackup, this, mapPath, std::move(contents));
+        }
+        
+        void Autosaver::writeBackup(const IO::Path& mapPath, const String& contents) {
             const IO::Path mapFilename = mapPath.lastComponent();
             const IO::Path mapBasename = mapFilename.deleteExtension();
             
@@ -87,30 +121,57 @@ namespace TrenchBroom {
                 
                 const IO::Path backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
 
-                m_lastSaveTime = time(NULL);
-                m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
+                m_writeFile(backupFilePath, contents);
                 
-                if (m_logger != NULL)
-                    m_logger->info("Created autosave backup at %s", backupFilePath.asString().c_str());
-                
-            } catch (FileSystemException e) {
-                if (m_logger != NULL)
-                    m_logger->error("Aborting autosave");
+                log(Logger::LogLevel_Info, "Created autosave backup at " + backupFilePath.asString());
+            } catch (const std::exception& e) {
+                log(Logger::LogLevel_Error, String("Aborting autosave: ") + e.what());
+            } catch (...) {
+                log(Logger::LogLevel_Error, "Aborting autosave");
             }
+            
+            postMessages();
+        }
+        
+        void Autosaver::writeFile(const IO::Path& path, const String& contents) {
+            IO::OpenFile open(path, true);
+            if (std::fwrite(contents.data(), 1, contents.size(), open.file) != contents.size() || std::fflush(open.file) != 0)
+                throw FileSystemException("Cannot write file: " + path.asString());
+        }
+        
+        /**
+         Passes the messages of the current backup to the UI thread, which logs them to the document once it drains the
+         notification queue. The document may be closed by then.
+         */
+        void Autosaver::postMessages() {
+            MessageList messages;
+            messages.swap(m_messages);
+            
+            const MapDocumentWPtr document = m_document;
+            m_notificationQueue.post([document, messages]() {
+                if (!expired(document)) {
+                    MapDocumentSPtr documentPtr = lock(document);
+                    for (const Message& message : messages)
+                        documentPtr->log(message.first, message.second);
+                }
+            });
+            wxWakeUpIdle();
+        }
+        
+        void Autosaver::log(const Logger::LogLevel level, const String& message) {
+            m_messages.push_back(std::make_pair(level, message));
         }
         
-        IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(const IO::Path& mapPath) const {
+        IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(const IO::Path& mapPath) {
             const IO::Path basePath = mapPath.deleteLastComponent();
             const IO::Path autosavePath = basePath + IO::Path("autosave");
 
             try {
                 // ensures that the directory exists or is created if it doesn't
                 return IO::WritableDiskFileSystem(autosavePath, true);
-            } catch (FileSystemException e) {
-                if (m_logger != NULL)
-                    m_logger->error("Cannot create autosave directory at %s", autosavePath.asString().c_str());
-                throw e;
+            } catch (const FileSystemException&) {
+                log(Logger::LogLevel_Error, "Cannot create autosave directory at " + autosavePath.asString());
+                throw;
             }
         }
 
@@ -148,18 +209,16 @@ namespace TrenchBroom {
             return backups;
         }
         
-        void Autosaver::thinBackups(IO::WritableDiskFileSystem& fs, IO::Path::List& backups) const {
+        void Autosaver::thinBackups(IO::WritableDiskFileSystem& fs, IO::Path::List& backups) {
             while (backups.size() > m_maxBackups - 1) {
                 const IO::Path filename = backups.front();
                 try {
                     fs.deleteFile(filename);
-                    if (m_logger != NULL)
-                        m_logger->debug("Deleted autosave backup %s", filename.asString().c_str());
+                    log(Logger::LogLevel_Debug, "Deleted autosave backup " + filename.asString());
                     backups.erase(std::begin(backups));
-                } catch (FileSystemException e) {
-                    if (m_logger != NULL)
-                        m_logger->error("Cannot delete autosave backup %s", filename.asString().c_str());
-                    throw e;
+                } catch (const FileSystemException&) {
+                    log(Logger::LogLevel_Error, "Cannot delete autosave backup " + filename.asString());
+                    throw;
                 }
             }
         }
@@ -20,13 +20,19 @@
 #ifndef TrenchBroom_Autosaver
 #define TrenchBroom_Autosaver
 
+#include "Logger.h"
+#include "StringUtils.h"
 #include "IO/Path.h"
 #include "View/ViewTypes.h"
 
 #include <ctime>
+#include <functional>
+#include <future>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
-    class Logger;
+    class NotificationQueue;
     
     namespace IO {
         class WritableDiskFileSystem;
@@ -35,10 +41,22 @@ namespace TrenchBroom {
     namespace View {
         class Command;
         
+        /**
+         Periodically writes backups of a modified document to the autosave folder next to the map file. The map is
+         serialized on the calling thread, but the backup files are rotated and written on a background thread.
+         When a backup is done, its messages are posted to the given notification queue, and they are logged to the
+         document when the queue is drained if the document still exists. The queue must outlive the autosaver.
+         */
         class Autosaver {
+        public:
+            typedef std::function<void(const IO::Path& path, const String& contents)> WriteFile;
         private:
+            typedef std::pair<Logger::LogLevel, String> Message;
+            typedef std::vector<Message> MessageList;
+            
             View::MapDocumentWPtr m_document;
-            Logger* m_logger;
+            NotificationQueue& m_notificationQueue;
+            WriteFile m_writeFile;
             
             time_t m_saveInterval;
             time_t m_idleInterval;
@@ -47,17 +65,26 @@ namespace TrenchBroom {
             time_t m_lastSaveTime;
             time_t m_lastModificationTime;
             size_t m_lastModificationCount;
+            
+            std::future<void> m_pendingBackup;
+            MessageList m_messages; // only accessed by the background thread
         public:
-            Autosaver(View::MapDocumentWPtr document, time_t saveInterval = 10 * 60, time_t idleInterval = 3, size_t maxBackups = 50);
+            Autosaver(View::MapDocumentWPtr document, NotificationQueue& notificationQueue, time_t saveInterval = 10 * 60, time_t idleInterval = 3, size_t maxBackups = 50, WriteFile writeFile = &Autosaver::writeFile);
             ~Autosaver();
             
-            void triggerAutosave(Logger* logger);
+            void triggerAutosave();
         private:
+            bool finishPendingBackup(bool wait);
             void autosave(View::MapDocumentSPtr document);
-            IO::WritableDiskFileSystem createBackupFileSystem(const IO::Path& mapPath) const;
+            void writeBackup(const IO::Path& mapPath, const String& contents);
+            static void writeFile(const IO::Path& path, const String& contents);
+            void postMessages();
+            void log(Logger::LogLevel level, const String& message);
+            
+            IO::WritableDiskFileSystem createBackupFileSystem(const IO::Path& mapPath);
             IO::Path::List collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             bool isBackup(const IO::Path& backupPath, const IO::Path& mapBasename) const;
-            void thinBackups(IO::WritableDiskFileSystem& fs, IO::Path::List& backups) const;
+            void thinBackups(IO::WritableDiskFileSystem& fs, IO::Path::List& backups);
             void cleanBackups(IO::WritableDiskFileSystem& fs, IO::Path::List& backups, const IO::Path& mapBasename) const;
             IO::Path makeBackupName(const IO::Path& mapBasename, const size_t index) const;
         private:
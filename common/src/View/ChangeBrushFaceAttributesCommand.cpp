@@ -71,5 +71,12 @@ namespace TrenchBroom {
             ChangeBrushFaceAttributesCommand* other = static_cast<ChangeBrushFaceAttributesCommand*>(command.get());
             return m_request.collateWith(other->m_request);
         }
+
+        size_t ChangeBrushFaceAttributesCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(ChangeBrushFaceAttributesCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
@@ -52,6 +52,7 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             bool doCollateWith(UndoableCommand::Ptr command);
+            size_t doGetMemoryUsage() const;
         private:
             ChangeBrushFaceAttributesCommand(const ChangeBrushFaceAttributesCommand& other);
             ChangeBrushFaceAttributesCommand& operator=(const ChangeBrushFaceAttributesCommand& other);
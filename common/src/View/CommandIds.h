@@ -99,6 +99,9 @@ namespace TrenchBroom {
                 const int DebugCreateCube                    = Lowest + 131;
                 const int DebugClipWithFace                  = Lowest + 132;
                 const int DebugCrashReportDialog             = Lowest + 133;
+                const int DebugPrintMemoryStatistics         = Lowest + 135;
+                const int DebugToggleRenderProfile           = Lowest + 136;
+                const int DebugExportRenderProfile           = Lowest + 137;
                 
                 const int RunCompile                         = Lowest + 133;
                 const int RunLaunch                          = Lowest + 134;
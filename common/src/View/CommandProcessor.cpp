@@ -26,6 +26,7 @@
 #include <wx/time.h>
 
 #include <algorithm>
+#include <iterator>
 
 namespace TrenchBroom {
     namespace View {
@@ -98,6 +99,14 @@ namespace TrenchBroom {
             return false;
         }
         
+        size_t CommandGroup::doGetMemoryUsage() const {
+            size_t result = sizeof(CommandGroup);
+            for (const UndoableCommand::Ptr& command : m_commands)
+                result += command->memoryUsage();
+            return result;
+        }
+        
+        const size_t CommandProcessor::DefaultMemoryBudget = 512 * 1024 * 1024;
         const wxLongLong CommandProcessor::CollationInterval(1000);
         
         struct CommandProcessor::SubmitAndStoreResult {
@@ -111,9 +120,11 @@ namespace TrenchBroom {
         
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document) :
         m_document(document),
+        m_memoryUsage(0),
         m_clearRepeatableCommandStack(false),
         m_lastCommandTimestamp(0),
-        m_groupLevel(0) {
+        m_groupLevel(0),
+        m_memoryBudget(DefaultMemoryBudget) {
             ensure(m_document != NULL, "document is null");
         }
         
@@ -137,6 +148,27 @@ namespace TrenchBroom {
             return m_nextCommandStack.back()->name();
         }
         
+        size_t CommandProcessor::lastCommandCount() const {
+            return m_lastCommandStack.size();
+        }
+        
+        size_t CommandProcessor::nextCommandCount() const {
+            return m_nextCommandStack.size();
+        }
+
+        size_t CommandProcessor::memoryUsage() const {
+            return m_memoryUsage;
+        }
+        
+        size_t CommandProcessor::memoryBudget() const {
+            return m_memoryBudget;
+        }
+        
+        void CommandProcessor::setMemoryBudget(const size_t memoryBudget) {
+            m_memoryBudget = memoryBudget;
+            enforceMemoryBudget();
+        }
+        
         void CommandProcessor::beginGroup(const String& name) {
             if (m_groupLevel == 0)
                 m_groupName = name;
@@ -161,8 +193,8 @@ namespace TrenchBroom {
             if (!success)
                 return false;
             
-            m_lastCommandStack.clear();
-            m_nextCommandStack.clear();
+            clearLastCommands();
+            clearNextCommands();
             return true;
         }
         
@@ -229,20 +261,26 @@ namespace TrenchBroom {
             assert(m_groupLevel == 0);
             
             clearRepeatableCommands();
-            m_lastCommandStack.clear();
-            m_nextCommandStack.clear();
+            clearLastCommands();
+            clearNextCommands();
             m_lastCommandTimestamp = 0;
         }
         
         CommandProcessor::SubmitAndStoreResult CommandProcessor::submitAndStoreCommand(UndoableCommand::Ptr command, const bool collate) {
             SubmitAndStoreResult result;
+            
+            // Commands are only prepared within groups because collation outside of groups depends on the time at
+            // which the command is stored.
+            if (collatesWithGroupedCommand(command, collate))
+                command->prepareForCollation();
+            
             result.submitted = doCommand(command);
             if (!result.submitted)
                 return result;
             
             result.stored = storeCommand(command, collate);
             if (!m_nextCommandStack.empty())
-                m_nextCommandStack.clear();
+                clearNextCommands();
             return result;
         }
         
@@ -280,6 +318,12 @@ namespace TrenchBroom {
             return pushGroupedCommand(command, collate);
         }
         
+        bool CommandProcessor::collatesWithGroupedCommand(UndoableCommand::Ptr command, const bool collate) const {
+            if (!collate || m_groupLevel == 0 || m_groupedCommands.empty())
+                return false;
+            return m_groupedCommands.back()->canCollateWith(command);
+        }
+        
         bool CommandProcessor::pushGroupedCommand(UndoableCommand::Ptr command, const bool collate) {
             assert(m_groupLevel > 0);
             if (!m_groupedCommands.empty()) {
@@ -331,10 +375,18 @@ namespace TrenchBroom {
             
             if (collatable(collate, timestamp)) {
                 UndoableCommand::Ptr lastCommand = m_lastCommandStack.back();
-                if (lastCommand->collateWith(command))
+                if (lastCommand->collateWith(command)) {
+                    updateLastCommandMemoryUsage();
+                    enforceMemoryBudget();
                     return false;
+                }
             }
+            
+            const size_t memoryUsage = command->memoryUsage();
             m_lastCommandStack.push_back(command);
+            m_lastCommandMemoryUsage.push_back(memoryUsage);
+            m_memoryUsage += memoryUsage;
+            enforceMemoryBudget();
             return true;
         }
         
@@ -342,9 +394,53 @@ namespace TrenchBroom {
             return collate && !m_lastCommandStack.empty() && timestamp - m_lastCommandTimestamp <= CollationInterval;
         }
         
+        /**
+         Discards the oldest undoable commands until the stacks fit into the memory budget. The most recent command is
+         always kept so that the last change can be undone.
+         */
+        void CommandProcessor::enforceMemoryBudget() {
+            size_t count = 0;
+            while (m_memoryUsage > m_memoryBudget && count + 1 < m_lastCommandStack.size()) {
+                m_memoryUsage -= m_lastCommandMemoryUsage[count];
+                ++count;
+            }
+            
+            if (count > 0) {
+                const auto difference = static_cast<CommandStack::difference_type>(count);
+                m_lastCommandStack.erase(std::begin(m_lastCommandStack), std::next(std::begin(m_lastCommandStack), difference));
+                m_lastCommandMemoryUsage.erase(std::begin(m_lastCommandMemoryUsage), std::next(std::begin(m_lastCommandMemoryUsage), difference));
+            }
+        }
+        
+        /**
+         Collating changes the last command, so its memory usage is estimated again.
+         */
+        void CommandProcessor::updateLastCommandMemoryUsage() {
+            const size_t memoryUsage = m_lastCommandStack.back()->memoryUsage();
+            m_memoryUsage = m_memoryUsage - m_lastCommandMemoryUsage.back() + memoryUsage;
+            m_lastCommandMemoryUsage.back() = memoryUsage;
+        }
+        
+        void CommandProcessor::clearLastCommands() {
+            for (const size_t memoryUsage : m_lastCommandMemoryUsage)
+                m_memoryUsage -= memoryUsage;
+            m_lastCommandStack.clear();
+            m_lastCommandMemoryUsage.clear();
+        }
+        
+        void CommandProcessor::clearNextCommands() {
+            for (const size_t memoryUsage : m_nextCommandMemoryUsage)
+                m_memoryUsage -= memoryUsage;
+            m_nextCommandStack.clear();
+            m_nextCommandMemoryUsage.clear();
+        }
+        
         void CommandProcessor::pushNextCommand(UndoableCommand::Ptr command) {
             assert(m_groupLevel == 0);
+            const size_t memoryUsage = command->memoryUsage();
             m_nextCommandStack.push_back(command);
+            m_nextCommandMemoryUsage.push_back(memoryUsage);
+            m_memoryUsage += memoryUsage;
         }
         
         void CommandProcessor::pushRepeatableCommand(UndoableCommand::Ptr command) {
@@ -365,6 +461,8 @@ namespace TrenchBroom {
                 throw CommandProcessorException("Command stack is empty");
             UndoableCommand::Ptr lastCommand = m_lastCommandStack.back();
             m_lastCommandStack.pop_back();
+            m_memoryUsage -= m_lastCommandMemoryUsage.back();
+            m_lastCommandMemoryUsage.pop_back();
             return lastCommand;
         }
         
@@ -374,6 +472,8 @@ namespace TrenchBroom {
                 throw CommandProcessorException("Command stack is empty");
             UndoableCommand::Ptr nextCommand = m_nextCommandStack.back();
             m_nextCommandStack.pop_back();
+            m_memoryUsage -= m_nextCommandMemoryUsage.back();
+            m_nextCommandMemoryUsage.pop_back();
             return nextCommand;
         }
         
@@ -62,9 +62,16 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
 
             bool doCollateWith(UndoableCommand::Ptr command);
+            size_t doGetMemoryUsage() const;
         };
         
+        /**
+         Executes commands and keeps the undo and redo stacks. The undo stack is limited by a memory budget: when the
+         estimated memory usage of the stored commands exceeds it, the oldest commands are discarded.
+         */
         class CommandProcessor {
+        public:
+            static const size_t DefaultMemoryBudget;
         private:
             static const wxLongLong CollationInterval;
             
@@ -74,12 +81,21 @@ namespace TrenchBroom {
             CommandStack m_lastCommandStack;
             CommandStack m_nextCommandStack;
             CommandStack m_repeatableCommandStack;
+            
+            // the memory usage of each command on the undo and redo stacks when it was stored, and their sum
+            typedef std::vector<size_t> MemoryUsageList;
+            MemoryUsageList m_lastCommandMemoryUsage;
+            MemoryUsageList m_nextCommandMemoryUsage;
+            size_t m_memoryUsage;
+            
             bool m_clearRepeatableCommandStack;
             wxLongLong m_lastCommandTimestamp;
             
             String m_groupName;
             CommandStack m_groupedCommands;
             size_t m_groupLevel;
+            
+            size_t m_memoryBudget;
 
             struct SubmitAndStoreResult;
         public:
@@ -98,6 +114,16 @@ namespace TrenchBroom {
             const String& lastCommandName() const;
             const String& nextCommandName() const;
             
+            size_t lastCommandCount() const;
+            size_t nextCommandCount() const;
+            
+            /**
+             Returns an estimate of the number of bytes occupied by the undo and redo stacks.
+             */
+            size_t memoryUsage() const;
+            size_t memoryBudget() const;
+            void setMemoryBudget(size_t memoryBudget);
+            
             void beginGroup(const String& name = "");
             void endGroup();
             void rollbackGroup();
@@ -118,6 +144,7 @@ namespace TrenchBroom {
             bool storeCommand(UndoableCommand::Ptr command, bool collate);
             
             void beginGroup(const String& name, bool undoable);
+            bool collatesWithGroupedCommand(UndoableCommand::Ptr command, bool collate) const;
             bool pushGroupedCommand(UndoableCommand::Ptr command, bool collate);
             UndoableCommand::Ptr popGroupedCommand();
             void createAndStoreCommandGroup();
@@ -126,6 +153,11 @@ namespace TrenchBroom {
             bool pushLastCommand(UndoableCommand::Ptr command, bool collate);
             bool collatable(bool collate, wxLongLong timestamp) const;
             
+            void enforceMemoryBudget();
+            void updateLastCommandMemoryUsage();
+            void clearLastCommands();
+            void clearNextCommands();
+            
             void pushNextCommand(UndoableCommand::Ptr command);
             void pushRepeatableCommand(UndoableCommand::Ptr command);
             
@@ -74,5 +74,12 @@ namespace TrenchBroom {
         bool CopyTexCoordSystemFromFaceCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t CopyTexCoordSystemFromFaceCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(CopyTexCoordSystemFromFaceCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
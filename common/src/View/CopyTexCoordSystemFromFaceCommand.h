@@ -53,6 +53,7 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             bool doCollateWith(UndoableCommand::Ptr command);
+            size_t doGetMemoryUsage() const;
         private:
             CopyTexCoordSystemFromFaceCommand(const CopyTexCoordSystemFromFaceCommand& other);
             CopyTexCoordSystemFromFaceCommand& operator=(const CopyTexCoordSystemFromFaceCommand& other);
@@ -29,7 +29,7 @@ namespace TrenchBroom {
         DocumentCommand::~DocumentCommand() {}
 
         bool DocumentCommand::performDo(MapDocumentCommandFacade* document) {
-            if (UndoableCommand::performDo(document)) {
+            if (performBatched(document, false)) {
                 document->incModificationCount(m_modificationCount);
                 return true;
             }
@@ -37,13 +37,19 @@ namespace TrenchBroom {
         }
         
         bool DocumentCommand::performUndo(MapDocumentCommandFacade* document) {
-            if (UndoableCommand::performUndo(document)) {
+            if (performBatched(document, true)) {
                 document->decModificationCount(m_modificationCount);
                 return true;
             }
             return false;
         }
         
+        bool DocumentCommand::performBatched(MapDocumentCommandFacade* document, const bool undo) {
+            // observers receive the node changes of this command at once before its modification count is updated
+            const MapDocumentCommandFacade::NodeChangeBatch batch(document);
+            return undo ? UndoableCommand::performUndo(document) : UndoableCommand::performDo(document);
+        }
+        
         bool DocumentCommand::collateWith(UndoableCommand::Ptr command) {
             if (UndoableCommand::collateWith(command)) {
                 m_modificationCount += command->documentModificationCount();
@@ -35,6 +35,7 @@ namespace TrenchBroom {
             bool performUndo(MapDocumentCommandFacade* document);
             bool collateWith(UndoableCommand::Ptr command);
         private:
+            bool performBatched(MapDocumentCommandFacade* document, bool undo);
             size_t documentModificationCount() const;
         private:
             DocumentCommand(const DocumentCommand& other);
@@ -19,6 +19,7 @@
 
 #include "DuplicateNodesCommand.h"
 
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
 #include "View/MapDocumentCommandFacade.h"
@@ -114,5 +115,17 @@ namespace TrenchBroom {
         bool DuplicateNodesCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+        
+        size_t DuplicateNodesCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(DuplicateNodesCommand);
+            result += (m_previouslySelectedNodes.capacity() + m_nodesToSelect.capacity()) * sizeof(Model::Node*);
+            
+            // the clones are owned by this command while it is undone
+            if (state() == CommandState_Default)
+                result += Model::estimateMemoryUsage(m_addedNodes);
+            else
+                result += Model::estimateReferenceMemoryUsage(m_addedNodes);
+            return result;
+        }
     }
 }
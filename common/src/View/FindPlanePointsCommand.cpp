@@ -59,5 +59,12 @@ namespace TrenchBroom {
         bool FindPlanePointsCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t FindPlanePointsCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(FindPlanePointsCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
@@ -43,6 +43,10 @@ namespace TrenchBroom {
             return m_contextManager->shaderManager();
         }
 
+        Renderer::RenderProfiler& GLContext::renderProfiler() {
+            return m_contextManager->renderProfiler();
+        }
+
         bool GLContext::initialize() {
             return m_contextManager->initialize();
         }
@@ -21,6 +21,7 @@
 
 #include "Renderer/FontManager.h"
 #include "Renderer/GL.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Vbo.h"
 
@@ -31,13 +32,15 @@ namespace TrenchBroom {
         m_vertexVbo(new Renderer::Vbo(0xFFFFFF)),
         m_indexVbo(new Renderer::Vbo(0xFFFFF, GL_ELEMENT_ARRAY_BUFFER)),
         m_fontManager(new Renderer::FontManager()),
-        m_shaderManager(new Renderer::ShaderManager()) {}
+        m_shaderManager(new Renderer::ShaderManager()),
+        m_renderProfiler(new Renderer::RenderProfiler()) {}
         
         GLContextManager::~GLContextManager() {
             delete m_vertexVbo;
             delete m_indexVbo;
             delete m_fontManager;
             delete m_shaderManager;
+            delete m_renderProfiler;
         }
 
         GLContext::Ptr GLContextManager::createContext(wxGLCanvas* canvas) {
@@ -79,5 +82,9 @@ namespace TrenchBroom {
         Renderer::ShaderManager& GLContextManager::shaderManager() {
             return *m_shaderManager;
         }
+
+        Renderer::RenderProfiler& GLContextManager::renderProfiler() {
+            return *m_renderProfiler;
+        }
     }
 }
@@ -27,6 +27,7 @@ class wxGLCanvas;
 namespace TrenchBroom {
     namespace Renderer {
         class FontManager;
+        class RenderProfiler;
         class ShaderManager;
         class Vbo;
     }
@@ -41,6 +42,7 @@ namespace TrenchBroom {
             Renderer::Vbo* m_indexVbo;
             Renderer::FontManager* m_fontManager;
             Renderer::ShaderManager* m_shaderManager;
+            Renderer::RenderProfiler* m_renderProfiler;
         public:
             GLContextManager();
             ~GLContextManager();
@@ -55,6 +57,7 @@ namespace TrenchBroom {
             Renderer::Vbo& indexVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
+            Renderer::RenderProfiler& renderProfiler();
         private:
             GLContextManager(const GLContextManager& other);
             GLContextManager& operator=(const GLContextManager& other);
@@ -22,6 +22,7 @@
 #include "Model/CollectMatchingIssuesVisitor.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
+#include "Model/ModelUtils.h"
 #include "Model/World.h"
 #include "View/MapDocument.h"
 #include "View/wxUtils.h"
@@ -165,6 +166,8 @@ namespace TrenchBroom {
             Model::World* world = document->world();
             if (world != NULL) {
                 const Model::IssueGeneratorList& issueGenerators = world->registeredIssueGenerators();
+                Model::validateIssues(world, issueGenerators);
+                
                 Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
                 world->acceptAndRecurse(visitor);
                 m_issues = visitor.issues();
@@ -71,10 +71,12 @@
 #include "Model/NodeVisitor.h"
 #include "Model/NonIntegerPlanePointsIssueGenerator.h"
 #include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/ParallelNodeTraversal.h"
 #include "Model/WorldBoundsIssueGenerator.h"
 #include "Model/PointEntityWithBrushesIssueGenerator.h"
 #include "Model/PointFile.h"
 #include "Model/World.h"
+#include "Renderer/Vbo.h"
 #include "View/AddRemoveNodesCommand.h"
 #include "View/ChangeBrushFaceAttributesCommand.h"
 #include "View/ChangeEntityAttributesCommand.h"
@@ -86,6 +88,7 @@
 #include "View/FindPlanePointsCommand.h"
 #include "View/Grid.h"
 #include "View/MapViewConfig.h"
+#include "View/NodeClipboard.h"
 #include "View/MoveBrushEdgesCommand.h"
 #include "View/MoveBrushFacesCommand.h"
 #include "View/MoveBrushVerticesCommand.h"
@@ -112,6 +115,7 @@
 #include "View/ViewEffectsService.h"
 
 #include <cassert>
+#include <map>
 
 namespace TrenchBroom {
     namespace View {
@@ -141,6 +145,7 @@ namespace TrenchBroom {
         
         MapDocument::~MapDocument() {
             unbindObservers();
+            NodeClipboard::instance().clear(this);
             
             if (isPointFileLoaded())
                 unloadPointFile();
@@ -226,6 +231,10 @@ namespace TrenchBroom {
             m_viewEffectsService = viewEffectsService;
         }
         
+        NotificationQueue& MapDocument::notificationQueue() {
+            return m_notificationQueue;
+        }
+        
         void MapDocument::newDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game) {
             info("Creating new document");
             
@@ -267,6 +276,15 @@ namespace TrenchBroom {
             m_game->writeMap(m_world, path);
         }
         
+        String MapDocument::serializeDocument() {
+            ensure(m_game.get() != NULL, "game is null");
+            ensure(m_world != NULL, "world is null");
+            
+            StringStream stream;
+            m_game->writeMapToStream(m_world, stream);
+            return stream.str();
+        }
+        
         void MapDocument::exportDocumentAs(const Model::ExportFormat format, const IO::Path& path) {
             m_game->exportMap(m_world, format, path);
         }
@@ -282,6 +300,7 @@ namespace TrenchBroom {
             if (m_world != NULL) {
                 documentWillBeClearedNotifier(this);
                 
+                NodeClipboard::instance().clear(this);
                 clearSelection();
                 unloadAssets();
                 clearWorld();
@@ -303,6 +322,43 @@ namespace TrenchBroom {
             return stream.str();
         }
         
+        class MapDocument::CloneParentQuery : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
+        private:
+            void doVisit(const Model::World* world)   { setResult(false); }
+            void doVisit(const Model::Layer* layer)   { setResult(false); }
+            void doVisit(const Model::Group* group)   { setResult(false); }
+            void doVisit(const Model::Entity* entity) { setResult(true);  }
+            void doVisit(const Model::Brush* brush)   { setResult(false); }
+        };
+        
+        Model::NodeList MapDocument::cloneSelectedNodes() {
+            Model::NodeList result;
+            Model::NodeMap parentClones;
+            
+            for (const Model::Node* node : m_selectedNodes.nodes()) {
+                Model::Node* clone = node->cloneRecursively(m_worldBounds);
+                
+                Model::Node* parent = node->parent();
+                CloneParentQuery query;
+                parent->accept(query);
+                
+                if (query.result()) {
+                    Model::Node*& parentClone = parentClones[parent];
+                    if (parentClone == NULL) {
+                        parentClone = parent->clone(m_worldBounds);
+                        result.push_back(parentClone);
+                    }
+                    parentClone->addChild(clone);
+                } else {
+                    result.push_back(clone);
+                }
+            }
+            
+            unsetEntityDefinitions(result);
+            unsetTextures(result);
+            return result;
+        }
+        
         PasteType MapDocument::paste(const String& str) {
             try {
                 const Model::NodeList nodes = m_game->parseNodes(str, m_world, m_worldBounds, this);
@@ -320,6 +376,12 @@ namespace TrenchBroom {
             return PT_Failed;
         }
         
+        PasteType MapDocument::paste(const Model::NodeList& nodes) {
+            if (!nodes.empty() && pasteNodes(nodes))
+                return PT_Node;
+            return PT_Failed;
+        }
+        
         bool MapDocument::pasteNodes(const Model::NodeList& nodes) {
             Model::MergeNodesIntoWorldVisitor mergeNodes(m_world, currentParent());
             Model::Node::accept(std::begin(nodes), std::end(nodes), mergeNodes);
@@ -455,8 +517,11 @@ namespace TrenchBroom {
         void MapDocument::selectTouching(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
             
+            // only the nodes whose bounds intersect a selected brush need to be tested
+            const Model::NodeList candidates = Model::collectNodesIntersecting(m_world, brushes);
+            
             Model::CollectTouchingNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), visitor);
             
             const Model::NodeList nodes = visitor.nodes();
             
@@ -471,8 +536,11 @@ namespace TrenchBroom {
         void MapDocument::selectInside(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
 
+            // only the nodes whose bounds intersect a selected brush need to be tested
+            const Model::NodeList candidates = Model::collectNodesIntersecting(m_world, brushes);
+            
             Model::CollectContainedNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), visitor);
             
             const Model::NodeList nodes = visitor.nodes();
 
@@ -486,7 +554,7 @@ namespace TrenchBroom {
         
         void MapDocument::selectNodesWithFilePosition(const std::vector<size_t>& positions) {
             Model::CollectSelectableNodesWithFilePositionVisitor visitor(*m_editorContext, positions);
-            m_world->acceptAndRecurse(visitor);
+            Model::parallelAcceptAndRecurse(m_world, visitor);
             
             Transaction transaction(this, "Select by Line Number");
             deselectAll();
@@ -538,6 +606,35 @@ namespace TrenchBroom {
         void MapDocument::invalidateSelectionBounds() {
             m_selectionBoundsValid = false;
         }
+
+        /**
+         Merges the bounds of the given newly selected nodes into the selection bounds instead of visiting the entire
+         selection again. Layers have no bounds, so their presence forces a full update.
+         */
+        void MapDocument::selectionBoundsDidGrow(const Model::NodeList& selectedNodes) {
+            if (!m_selectionBoundsValid || selectedNodes.empty())
+                return;
+            
+            if (m_selectedNodes.hasLayers()) {
+                invalidateSelectionBounds();
+            } else if (m_selectedNodes.nodeCount() == selectedNodes.size()) {
+                m_selectionBounds = Model::computeBounds(selectedNodes);
+            } else {
+                m_selectionBounds.mergeWith(Model::computeBounds(selectedNodes));
+            }
+        }
+        
+        /**
+         Bounds cannot be shrunk incrementally, so they are only kept up to date if the selection is now empty.
+         */
+        void MapDocument::selectionBoundsDidShrink() {
+            if (m_selectedNodes.empty()) {
+                m_selectionBounds = BBox3();
+                m_selectionBoundsValid = true;
+            } else {
+                invalidateSelectionBounds();
+            }
+        }
         
         void MapDocument::validateSelectionBounds() const {
             Model::ComputeNodeBoundsVisitor visitor;
@@ -892,20 +989,22 @@ namespace TrenchBroom {
             if (!hasSelectedBrushFaces() && !selectedNodes().hasOnlyBrushes())
                 return false;
             
-            Polyhedron3 polyhedron;
+            Vec3::List points;
             
             if (hasSelectedBrushFaces()) {
                 for (const Model::BrushFace* face : selectedBrushFaces()) {
                     for (const Model::BrushVertex* vertex : face->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             } else if (selectedNodes().hasOnlyBrushes()) {
                 for (const Model::Brush* brush : selectedNodes().brushes()) {
                     for (const Model::BrushVertex* vertex : brush->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             }
             
+            const Polyhedron3 polyhedron(points);
+            
             if (!polyhedron.polyhedron() || !polyhedron.closed())
                 return false;
             
@@ -1178,6 +1277,94 @@ namespace TrenchBroom {
                 }
             }
         }
+        
+        MapDocument::MemoryStatistics::MemoryStatistics() :
+        brushCount(0),
+        brushFaceCount(0),
+        brushMemory(0),
+        brushFaceMemory(0),
+        brushGeometryMemory(0),
+        brushGeometryReservedMemory(0),
+        textureMemory(0),
+        entityModelCount(0),
+        entityModelMemory(0),
+        vboMemory(0),
+        commandMemory(0) {}
+        
+        size_t MapDocument::MemoryStatistics::totalMemory() const {
+            return brushMemory + brushFaceMemory + brushGeometryReservedMemory + textureMemory + entityModelMemory + vboMemory + commandMemory;
+        }
+        
+        class CountBrushes : public Model::NodeVisitor {
+        public:
+            size_t brushCount;
+            size_t faceCount;
+            
+            CountBrushes() :
+            brushCount(0),
+            faceCount(0) {}
+        private:
+            void doVisit(Model::World* world)   {}
+            void doVisit(Model::Layer* layer)   {}
+            void doVisit(Model::Group* group)   {}
+            void doVisit(Model::Entity* entity) {}
+            void doVisit(Model::Brush* brush)   {
+                ++brushCount;
+                faceCount += brush->faceCount();
+            }
+        };
+        
+        MapDocument::MemoryStatistics MapDocument::memoryStatistics() const {
+            MemoryStatistics result;
+            
+            if (m_world != NULL) {
+                CountBrushes visitor;
+                m_world->acceptAndRecurse(visitor);
+                result.brushCount = visitor.brushCount;
+                result.brushFaceCount = visitor.faceCount;
+                result.brushMemory = visitor.brushCount * sizeof(Model::Brush);
+                result.brushFaceMemory = visitor.faceCount * sizeof(Model::BrushFace);
+            }
+            
+            result.brushGeometryMemory = (Model::BrushGeometry::Vertex::usedMemory() +
+                                          Model::BrushGeometry::Edge::usedMemory() +
+                                          Model::BrushGeometry::HalfEdge::usedMemory() +
+                                          Model::BrushGeometry::Face::usedMemory());
+            result.brushGeometryReservedMemory = (Model::BrushGeometry::Vertex::reservedMemory() +
+                                                  Model::BrushGeometry::Edge::reservedMemory() +
+                                                  Model::BrushGeometry::HalfEdge::reservedMemory() +
+                                                  Model::BrushGeometry::Face::reservedMemory());
+            
+            result.textureMemory = m_textureManager->memoryUsage();
+            result.entityModelCount = m_entityModelManager->modelCount();
+            result.entityModelMemory = m_entityModelManager->memoryUsage();
+            result.vboMemory = Renderer::Vbo::totalCapacity();
+            result.commandMemory = doGetCommandMemoryUsage();
+            return result;
+        }
+        
+        void MapDocument::printMemoryStatistics() {
+            StringStream str;
+            str << memoryStatistics();
+            info(str.str());
+        }
+        
+        static size_t kibibytes(const size_t bytes) {
+            return (bytes + 1023) / 1024;
+        }
+        
+        std::ostream& operator<<(std::ostream& str, const MapDocument::MemoryStatistics& statistics) {
+            str << "Memory statistics (KiB)" << std::endl;
+            str << "  Brushes:         " << kibibytes(statistics.brushMemory) << " (" << statistics.brushCount << " brushes)" << std::endl;
+            str << "  Brush faces:     " << kibibytes(statistics.brushFaceMemory) << " (" << statistics.brushFaceCount << " faces)" << std::endl;
+            str << "  Brush geometry:  " << kibibytes(statistics.brushGeometryMemory) << " (" << kibibytes(statistics.brushGeometryReservedMemory) << " reserved)" << std::endl;
+            str << "  Textures:        " << kibibytes(statistics.textureMemory) << std::endl;
+            str << "  Entity models:   " << kibibytes(statistics.entityModelMemory) << " (" << statistics.entityModelCount << " models)" << std::endl;
+            str << "  VBOs:            " << kibibytes(statistics.vboMemory) << std::endl;
+            str << "  Undo history:    " << kibibytes(statistics.commandMemory) << std::endl;
+            str << "  Total:           " << kibibytes(statistics.totalMemory());
+            return str;
+        }
 
         bool MapDocument::canUndoLastCommand() const {
             return doCanUndoLastCommand();
@@ -1211,6 +1398,14 @@ namespace TrenchBroom {
             doClearRepeatableCommands();
         }
         
+        size_t MapDocument::lastCommandCount() const {
+            return doGetLastCommandCount();
+        }
+        
+        void MapDocument::setCommandMemoryBudget(const size_t memoryBudget) {
+            doSetCommandMemoryBudget(memoryBudget);
+        }
+        
         void MapDocument::beginTransaction(const String& name) {
             doBeginTransaction(name);
         }
@@ -1431,10 +1626,21 @@ namespace TrenchBroom {
         
         class SetTextures : public Model::NodeVisitor {
         private:
-            Assets::TextureManager* m_manager;
+            // faces with equal texture names share the same name string, so each distinct name is only looked up once
+            typedef std::map<const String*, Model::BrushFaceList> FacesByTextureName;
+            FacesByTextureName m_faces;
         public:
-            SetTextures(Assets::TextureManager* manager) :
-            m_manager(manager) {}
+            void addFace(Model::BrushFace* face) {
+                m_faces[&face->textureName()].push_back(face);
+            }
+            
+            void apply(Assets::TextureManager* manager) const {
+                for (const FacesByTextureName::value_type& entry : m_faces) {
+                    Assets::Texture* texture = manager->texture(*entry.first);
+                    for (Model::BrushFace* face : entry.second)
+                        face->updateTexture(texture);
+                }
+            }
         private:
             void doVisit(Model::World* world)   {}
             void doVisit(Model::Layer* layer)   {}
@@ -1442,23 +1648,27 @@ namespace TrenchBroom {
             void doVisit(Model::Entity* entity) {}
             void doVisit(Model::Brush* brush)   {
                 for (Model::BrushFace* face : brush->faces())
-                    face->updateTexture(m_manager);
+                    addFace(face);
             }
         };
         
         void MapDocument::setTextures() {
-            SetTextures visitor(m_textureManager);
+            SetTextures visitor;
             m_world->acceptAndRecurse(visitor);
+            visitor.apply(m_textureManager);
         }
         
         void MapDocument::setTextures(const Model::NodeList& nodes) {
-            SetTextures visitor(m_textureManager);
+            SetTextures visitor;
             Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            visitor.apply(m_textureManager);
         }
         
         void MapDocument::setTextures(const Model::BrushFaceList& faces) {
+            SetTextures visitor;
             for (Model::BrushFace* face : faces)
-                face->updateTexture(m_textureManager);
+                visitor.addFace(face);
+            visitor.apply(m_textureManager);
         }
         
         class UnsetTextures : public Model::NodeVisitor {
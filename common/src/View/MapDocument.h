@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_MapDocument
 #define TrenchBroom_MapDocument
 
+#include "NotificationQueue.h"
 #include "Notifier.h"
 #include "TrenchBroom.h"
 #include "VecMath.h"
@@ -95,6 +96,7 @@ namespace TrenchBroom {
             mutable bool m_selectionBoundsValid;
             
             ViewEffectsService* m_viewEffectsService;
+            NotificationQueue m_notificationQueue;
         public: // notification
             Notifier1<Command::Ptr> commandDoNotifier;
             Notifier1<Command::Ptr> commandDoneNotifier;
@@ -167,12 +169,19 @@ namespace TrenchBroom {
             Model::PointFile* pointFile() const;
             
             void setViewEffectsService(ViewEffectsService* viewEffectsService);
+
+            /**
+             Returns the queue through which worker threads can notify the observers of this document. The queue is
+             drained on the UI thread whenever it becomes idle, so workers should call wxWakeUpIdle after posting.
+             */
+            NotificationQueue& notificationQueue();
         public: // new, load, save document
             void newDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game);
             void loadDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
+            String serializeDocument();
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
@@ -181,8 +190,22 @@ namespace TrenchBroom {
             String serializeSelectedNodes();
             String serializeSelectedBrushFaces();
             
+            /**
+             Returns recursive clones of the selected nodes, structured like the serialized selected nodes: selected
+             brushes of an entity other than worldspawn are added to a clone of their entity. Like the serialized
+             nodes, the clones do not refer to any textures or entity definitions. The caller takes ownership of the
+             clones.
+             */
+            Model::NodeList cloneSelectedNodes();
+            
             PasteType paste(const String& str);
+            
+            /**
+             Pastes the given nodes, which must not have a parent, and takes ownership of them.
+             */
+            PasteType paste(const Model::NodeList& nodes);
         private:
+            class CloneParentQuery;
             bool pasteNodes(const Model::NodeList& nodes);
             bool pasteBrushFaces(const Model::BrushFaceList& faces);
         public: // point file management
@@ -223,6 +246,8 @@ namespace TrenchBroom {
         protected:
             void updateLastSelectionBounds();
             void invalidateSelectionBounds();
+            void selectionBoundsDidGrow(const Model::NodeList& selectedNodes);
+            void selectionBoundsDidShrink();
         private:
             void validateSelectionBounds() const;
             void clearSelection();
@@ -322,6 +347,30 @@ namespace TrenchBroom {
             virtual void performRebuildBrushGeometry(const Model::BrushList& brushes) = 0;
         public: // debug commands
             void printVertices();
+        public: // memory statistics
+            /**
+             The memory used by the parts of this document in bytes. The brush geometry and VBO figures include all
+             open documents because their memory is shared.
+             */
+            struct MemoryStatistics {
+                size_t brushCount;
+                size_t brushFaceCount;
+                size_t brushMemory;
+                size_t brushFaceMemory;
+                size_t brushGeometryMemory;
+                size_t brushGeometryReservedMemory;
+                size_t textureMemory;
+                size_t entityModelCount;
+                size_t entityModelMemory;
+                size_t vboMemory;
+                size_t commandMemory;
+                
+                MemoryStatistics();
+                size_t totalMemory() const;
+            };
+            
+            MemoryStatistics memoryStatistics() const;
+            void printMemoryStatistics();
         public: // command processing
             bool canUndoLastCommand() const;
             bool canRedoNextCommand() const;
@@ -331,6 +380,8 @@ namespace TrenchBroom {
             void redoNextCommand();
             bool repeatLastCommands();
             void clearRepeatableCommands();
+            size_t lastCommandCount() const;
+            void setCommandMemoryBudget(size_t memoryBudget);
         public: // transactions
             void beginTransaction(const String& name = "");
             void rollbackTransaction();
@@ -348,6 +399,8 @@ namespace TrenchBroom {
             virtual void doRedoNextCommand() = 0;
             virtual bool doRepeatLastCommands() = 0;
             virtual void doClearRepeatableCommands() = 0;
+            virtual size_t doGetLastCommandCount() const = 0;
+            virtual void doSetCommandMemoryBudget(size_t memoryBudget) = 0;
             
             virtual void doBeginTransaction(const String& name) = 0;
             virtual void doEndTransaction() = 0;
@@ -355,6 +408,7 @@ namespace TrenchBroom {
 
             virtual bool doSubmit(Command::Ptr command) = 0;
             virtual bool doSubmitAndStore(UndoableCommand::Ptr command) = 0;
+            virtual size_t doGetCommandMemoryUsage() const = 0;
         public: // asset state management
             void commitPendingAssets();
         public: // picking
@@ -433,6 +487,8 @@ namespace TrenchBroom {
             void commandDone(Command::Ptr command);
             void commandUndone(UndoableCommand::Ptr command);
         };
+        
+        std::ostream& operator<<(std::ostream& str, const MapDocument::MemoryStatistics& statistics);
 
         class Transaction {
         private:
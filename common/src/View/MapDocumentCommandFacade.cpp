@@ -27,6 +27,7 @@
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/CollectNodesWithDescendantSelectionCountVisitor.h"
 #include "Model/CollectRecursivelySelectedNodesVisitor.h"
 #include "Model/CollectSelectableBrushFacesVisitor.h"
@@ -37,6 +38,7 @@
 #include "Model/Group.h"
 #include "Model/Issue.h"
 #include "Model/ModelUtils.h"
+#include "Model/ParallelNodeTraversal.h"
 #include "Model/Snapshot.h"
 #include "Model/TransformObjectVisitor.h"
 #include "Model/World.h"
@@ -44,12 +46,29 @@
 
 namespace TrenchBroom {
     namespace View {
+        class MapDocumentCommandFacade::NotifyNodesChange {
+        private:
+            MapDocumentCommandFacade& m_document;
+            const Model::NodeList& m_nodes;
+        public:
+            NotifyNodesChange(MapDocumentCommandFacade& document, const Model::NodeList& nodes) :
+            m_document(document),
+            m_nodes(nodes) {
+                m_document.nodesWillChange(m_nodes);
+            }
+            
+            ~NotifyNodesChange() {
+                m_document.nodesDidChange(m_nodes);
+            }
+        };
+        
         MapDocumentSPtr MapDocumentCommandFacade::newMapDocument() {
             return MapDocumentSPtr(new MapDocumentCommandFacade());
         }
 
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
-        m_commandProcessor(this) {
+        m_commandProcessor(this),
+        m_nodeChangeBatchLevel(0) {
             bindObservers();
         }
 
@@ -83,8 +102,8 @@ namespace TrenchBroom {
             selection.addPartiallySelectedNodes(partiallySelected);
             selection.addRecursivelySelectedNodes(recursivelySelected);
             
+            selectionBoundsDidGrow(selected);
             selectionDidChangeNotifier(selection);
-            invalidateSelectionBounds();
         }
         
         void MapDocumentCommandFacade::performSelect(const Model::BrushFaceList& faces) {
@@ -119,7 +138,7 @@ namespace TrenchBroom {
             performDeselectAll();
             
             Model::CollectSelectableNodesVisitor visitor(*m_editorContext);
-            m_world->acceptAndRecurse(visitor);
+            Model::parallelAcceptAndRecurse(m_world, visitor);
             performSelect(visitor.nodes());
         }
         
@@ -127,7 +146,7 @@ namespace TrenchBroom {
             performDeselectAll();
             
             Model::CollectSelectableBrushFacesVisitor visitor(*m_editorContext);
-            m_world->acceptAndRecurse(visitor);
+            Model::parallelAcceptAndRecurse(m_world, visitor);
             performSelect(visitor.faces());
         }
 
@@ -169,8 +188,8 @@ namespace TrenchBroom {
             selection.addPartiallyDeselectedNodes(partiallyDeselected);
             selection.addRecursivelyDeselectedNodes(recursivelyDeselected);
             
+            selectionBoundsDidShrink();
             selectionDidChangeNotifier(selection);
-            invalidateSelectionBounds();
         }
         
         void MapDocumentCommandFacade::performDeselect(const Model::BrushFaceList& faces) {
@@ -227,8 +246,8 @@ namespace TrenchBroom {
             m_selectedNodes.clear();
             m_partiallySelectedNodes.clear();
             
+            selectionBoundsDidShrink();
             selectionDidChangeNotifier(selection);
-            invalidateSelectionBounds();
         }
         
         void MapDocumentCommandFacade::deselectAllBrushFaces() {
@@ -249,7 +268,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performAddNodes(const Model::ParentChildrenMap& nodes) {
             const Model::NodeList parents = collectParents(nodes);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            const NotifyNodesChange notifyParents(*this, parents);
             
             Model::NodeList addedNodes;
             for (const auto& entry : nodes) {
@@ -268,9 +287,10 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performRemoveNodes(const Model::ParentChildrenMap& nodes) {
             const Model::NodeList parents = collectParents(nodes);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            const NotifyNodesChange notifyParents(*this, parents);
             
             const Model::NodeList allChildren = collectChildren(nodes);
+            notifyRemovedNodesDidChange(allChildren);
             Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyChildren(nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allChildren);
             
             for (const auto& entry : nodes) {
@@ -405,8 +425,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             RenameGroupsVisitor visitor(newName);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -417,8 +437,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
 
             UndoRenameGroupsVisitor visitor(newNames);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -435,23 +455,15 @@ namespace TrenchBroom {
             groupWasClosedNotifier(previousGroup);
         }
 
-        void
-        MapDocumentCommandFacade::performTransform(const Mat4x4 &transform,
-                                                   const bool lockTextures) {
-          const Model::NodeList &nodes = m_selectedNodes.nodes();
-          const Model::NodeList parents = collectParents(nodes);
-
-          Notifier1<const Model::NodeList &>::NotifyBeforeAndAfter
-              notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier,
-                            parents);
-          Notifier1<const Model::NodeList &>::NotifyBeforeAndAfter notifyNodes(
-              nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
-
-          Model::TransformObjectVisitor visitor(transform, lockTextures,
-                                                m_worldBounds);
-          Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
-
-          invalidateSelectionBounds();
+        void MapDocumentCommandFacade::performTransform(const Mat4x4& transform, const bool lockTextures) {
+            const Model::NodeList& nodes = m_selectedNodes.nodes();
+            const Model::NodeList parents = collectParents(nodes);
+            
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
+            
+            Model::transformObjects(nodes, transform, lockTextures, m_worldBounds);
+            invalidateSelectionBounds();
         }
 
         Model::EntityAttributeSnapshot::Map MapDocumentCommandFacade::performSetAttribute(const Model::AttributeName& name, const Model::AttributeValue& value) {
@@ -459,8 +471,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
 
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Model::EntityAttributeSnapshot::Map snapshot;
             
@@ -479,8 +491,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             static const Model::AttributeValue DefaultValue = "";
             Model::EntityAttributeSnapshot::Map snapshot;
@@ -500,8 +512,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(attributableNodes.begin(), attributableNodes.end());
             const Model::NodeList parents = collectParents(nodes.begin(), nodes.end());
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Model::EntityAttributeSnapshot::Map snapshot;
             
@@ -533,8 +545,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             static const Model::AttributeValue DefaultValue = "";
             Model::EntityAttributeSnapshot::Map snapshot;
@@ -555,8 +567,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             for (Model::AttributableNode* node : attributableNodes)
                 node->renameAttribute(oldName, newName);
@@ -569,8 +581,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
 
             for (const auto& entry : attributes) {
                 Model::AttributableNode* node = entry.first;
@@ -602,8 +614,8 @@ namespace TrenchBroom {
             }
             
             const Model::NodeList parents = collectParents(std::begin(changedNodes), std::end(changedNodes));
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, changedNodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, changedNodes);
 
             for (Model::BrushFace* face : faces) {
                 Model::Brush* brush = face->brush();
@@ -655,11 +667,10 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(brushes), std::end(brushes));
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
-            for (Model::Brush* brush : brushes)
-                brush->findIntegerPlanePoints(m_worldBounds);
+            Model::Brush::findIntegerPlanePoints(brushes, m_worldBounds);
             
             return snapshot;
         }
@@ -671,8 +682,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(brushes), std::end(brushes));
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
 
             size_t succeededBrushCount = 0;
             size_t failedBrushCount = 0;
@@ -706,8 +717,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : vertices) {
@@ -726,8 +737,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Edge3::List newEdgePositions;
             for (const auto& entry : edges) {
@@ -744,8 +755,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Polygon3::List newFacePositions;
             for (const auto& entry : faces) {
@@ -764,8 +775,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : edges) {
@@ -786,8 +797,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : faces) {
@@ -808,8 +819,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : vertices) {
@@ -825,8 +836,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes = VectorUtils::cast<Model::Node*>(brushes);
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyParents(*this, parents);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             
             for (Model::Brush* brush : brushes)
                 brush->rebuildGeometry(m_worldBounds);
@@ -839,8 +850,8 @@ namespace TrenchBroom {
                 const Model::NodeList& nodes = m_selectedNodes.nodes();
                 const Model::NodeList parents = collectParents(nodes);
                 
-                Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-                Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+                const NotifyNodesChange notifyParents(*this, parents);
+                const NotifyNodesChange notifyNodes(*this, nodes);
                 
                 snapshot->restoreNodes(m_worldBounds);
                 
@@ -857,7 +868,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performSetEntityDefinitionFile(const Assets::EntityDefinitionFileSpec& spec) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             Notifier0::NotifyAfter notifyEntityDefinitions(entityDefinitionsDidChangeNotifier);
             
             // to avoid backslashes being misinterpreted as escape sequences
@@ -868,7 +879,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performSetTextureCollections(const IO::Path::List& paths) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             Notifier0::NotifyAfter notifyTextureCollections(textureCollectionsDidChangeNotifier);
             
             unsetTextures();
@@ -879,7 +890,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performSetMods(const StringList& mods) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            const NotifyNodesChange notifyNodes(*this, nodes);
             Notifier0::NotifyAfter notifyMods(modsDidChangeNotifier);
 
             const String newValue = StringUtils::join(mods, ";");
@@ -914,6 +925,83 @@ namespace TrenchBroom {
             documentModificationStateDidChangeNotifier();
         }
 
+        MapDocumentCommandFacade::NodeChangeBatch::NodeChangeBatch(MapDocumentCommandFacade* document) :
+        m_document(document) {
+            m_document->beginNodeChangeBatch();
+        }
+        
+        MapDocumentCommandFacade::NodeChangeBatch::~NodeChangeBatch() {
+            m_document->endNodeChangeBatch();
+        }
+        
+        void MapDocumentCommandFacade::beginNodeChangeBatch() {
+            ++m_nodeChangeBatchLevel;
+        }
+        
+        void MapDocumentCommandFacade::endNodeChangeBatch() {
+            assert(m_nodeChangeBatchLevel > 0);
+            if (--m_nodeChangeBatchLevel > 0 || m_changedNodes.empty())
+                return;
+            
+            // a node that was removed and added again may be listed twice
+            Model::NodeList changedNodes;
+            changedNodes.reserve(m_changedNodeSet.size());
+            for (Model::Node* node : m_changedNodes) {
+                if (m_changedNodeSet.erase(node) > 0)
+                    changedNodes.push_back(node);
+            }
+            m_changedNodes.clear();
+            m_changedNodeSet.clear();
+            
+            if (!changedNodes.empty())
+                nodesDidChangeNotifier(changedNodes);
+        }
+        
+        void MapDocumentCommandFacade::nodesWillChange(const Model::NodeList& nodes) {
+            if (m_nodeChangeBatchLevel == 0) {
+                nodesWillChangeNotifier(nodes);
+                return;
+            }
+            
+            Model::NodeList newNodes;
+            newNodes.reserve(nodes.size());
+            for (Model::Node* node : nodes) {
+                if (m_changedNodeSet.insert(node).second) {
+                    newNodes.push_back(node);
+                    m_changedNodes.push_back(node);
+                }
+            }
+            
+            if (!newNodes.empty())
+                nodesWillChangeNotifier(newNodes);
+        }
+        
+        void MapDocumentCommandFacade::nodesDidChange(const Model::NodeList& nodes) {
+            if (m_nodeChangeBatchLevel == 0)
+                nodesDidChangeNotifier(nodes);
+        }
+        
+        /**
+         Removed nodes must not be reported as changed when the batch ends, so the changed nodes among the given nodes
+         and their descendants are reported now while they are still part of the document.
+         */
+        void MapDocumentCommandFacade::notifyRemovedNodesDidChange(const Model::NodeList& nodes) {
+            if (m_nodeChangeBatchLevel == 0 || m_changedNodeSet.empty())
+                return;
+            
+            Model::CollectNodesVisitor visitor;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            
+            Model::NodeList changedNodes;
+            for (Model::Node* node : visitor.nodes()) {
+                if (m_changedNodeSet.erase(node) > 0)
+                    changedNodes.push_back(node);
+            }
+            
+            if (!changedNodes.empty())
+                nodesDidChangeNotifier(changedNodes);
+        }
+
         void MapDocumentCommandFacade::bindObservers() {
             m_commandProcessor.commandDoNotifier.addObserver(commandDoNotifier);
             m_commandProcessor.commandDoneNotifier.addObserver(commandDoneNotifier);
@@ -965,6 +1053,14 @@ namespace TrenchBroom {
             m_commandProcessor.clearRepeatableCommands();
         }
 
+        size_t MapDocumentCommandFacade::doGetLastCommandCount() const {
+            return m_commandProcessor.lastCommandCount();
+        }
+
+        void MapDocumentCommandFacade::doSetCommandMemoryBudget(const size_t memoryBudget) {
+            m_commandProcessor.setMemoryBudget(memoryBudget);
+        }
+
         void MapDocumentCommandFacade::doBeginTransaction(const String& name) {
             m_commandProcessor.beginGroup(name);
         }
@@ -984,5 +1080,9 @@ namespace TrenchBroom {
         bool MapDocumentCommandFacade::doSubmitAndStore(UndoableCommand::Ptr command) {
             return m_commandProcessor.submitAndStoreCommand(command);
         }
+        
+        size_t MapDocumentCommandFacade::doGetCommandMemoryUsage() const {
+            return m_commandProcessor.memoryUsage();
+        }
     }
 }
@@ -42,6 +42,10 @@ namespace TrenchBroom {
         class MapDocumentCommandFacade : public MapDocument {
         private:
             CommandProcessor m_commandProcessor;
+            
+            size_t m_nodeChangeBatchLevel;
+            Model::NodeSet m_changedNodeSet;
+            Model::NodeList m_changedNodes;
         public:
             static MapDocumentSPtr newMapDocument();
         private:
@@ -118,6 +122,28 @@ namespace TrenchBroom {
         public: // modification count
             void incModificationCount(size_t delta = 1);
             void decModificationCount(size_t delta = 1);
+        public: // node change notifications
+            /**
+             Merges the node change notifications that are sent while a batch exists. Observers are notified that a
+             node will change before its first change only, and they are notified once of all nodes that did change
+             when the outermost batch ends. Changed nodes that are removed during the batch are reported right before
+             they are removed.
+             */
+            class NodeChangeBatch {
+            private:
+                MapDocumentCommandFacade* m_document;
+            public:
+                NodeChangeBatch(MapDocumentCommandFacade* document);
+                ~NodeChangeBatch();
+            };
+        private:
+            class NotifyNodesChange;
+            
+            void beginNodeChangeBatch();
+            void endNodeChangeBatch();
+            void nodesWillChange(const Model::NodeList& nodes);
+            void nodesDidChange(const Model::NodeList& nodes);
+            void notifyRemovedNodesDidChange(const Model::NodeList& nodes);
         private: // notification
             void bindObservers();
             void documentWasNewed(MapDocument* document);
@@ -131,6 +157,8 @@ namespace TrenchBroom {
             void doRedoNextCommand();
             bool doRepeatLastCommands();
             void doClearRepeatableCommands();
+            size_t doGetLastCommandCount() const;
+            void doSetCommandMemoryBudget(size_t memoryBudget);
             
             void doBeginTransaction(const String& name);
             void doEndTransaction();
@@ -138,6 +166,7 @@ namespace TrenchBroom {
 
             bool doSubmit(Command::Ptr command);
             bool doSubmitAndStore(UndoableCommand::Ptr command);
+            size_t doGetCommandMemoryUsage() const;
         };
     }
 }
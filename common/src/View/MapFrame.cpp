@@ -34,6 +34,7 @@
 #include "Model/NodeCollection.h"
 #include "Model/PointFile.h"
 #include "Model/World.h"
+#include "Renderer/RenderProfiler.h"
 #include "View/ActionManager.h"
 #include "View/Autosaver.h"
 #include "View/BorderLine.h"
@@ -51,6 +52,7 @@
 #include "View/MapDocument.h"
 #include "View/MapFrameDropTarget.h"
 #include "View/Menu.h"
+#include "View/NodeClipboard.h"
 #include "View/OpenClipboard.h"
 #include "View/RenderView.h"
 #include "View/ReplaceTextureDialog.h"
@@ -61,6 +63,7 @@
 #include "View/wxUtils.h"
 
 #include <wx/clipbrd.h>
+#include <wx/dataobj.h>
 #include <wx/display.h>
 #include <wx/filedlg.h>
 #include <wx/textdlg.h>
@@ -73,8 +76,11 @@
 #include <wx/choicdlg.h>
 #include <wx/toolbar.h>
 #include <wx/statusbr.h>
+#include <wx/utils.h>
 
 #include <cassert>
+#include <cstring>
+#include <fstream>
 
 namespace TrenchBroom {
     namespace View {
@@ -114,7 +120,7 @@ namespace TrenchBroom {
 
             m_frameManager = frameManager;
             m_document = document;
-            m_autosaver = new Autosaver(m_document);
+            m_autosaver = new Autosaver(m_document, m_document->notificationQueue());
 
             m_contextManager = new GLContextManager();
 
@@ -712,6 +718,9 @@ namespace TrenchBroom {
             Bind(wxEVT_MENU, &MapFrame::OnRunLaunch, this, CommandIds::Menu::RunLaunch);
             
             Bind(wxEVT_MENU, &MapFrame::OnDebugPrintVertices, this, CommandIds::Menu::DebugPrintVertices);
+            Bind(wxEVT_MENU, &MapFrame::OnDebugPrintMemoryStatistics, this, CommandIds::Menu::DebugPrintMemoryStatistics);
+            Bind(wxEVT_MENU, &MapFrame::OnDebugToggleRenderProfile, this, CommandIds::Menu::DebugToggleRenderProfile);
+            Bind(wxEVT_MENU, &MapFrame::OnDebugExportRenderProfile, this, CommandIds::Menu::DebugExportRenderProfile);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCreateBrush, this, CommandIds::Menu::DebugCreateBrush);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCreateCube, this, CommandIds::Menu::DebugCreateCube);
             Bind(wxEVT_MENU, &MapFrame::OnDebugClipBrush, this, CommandIds::Menu::DebugClipWithFace);
@@ -737,6 +746,7 @@ namespace TrenchBroom {
 
             Bind(wxEVT_CLOSE_WINDOW, &MapFrame::OnClose, this);
             Bind(wxEVT_TIMER, &MapFrame::OnAutosaveTimer, this);
+            Bind(wxEVT_IDLE, &MapFrame::OnIdle, this);
             Bind(wxEVT_CHILD_FOCUS, &MapFrame::OnChildFocus, this);
 
             m_gridChoice->Bind(wxEVT_CHOICE, &MapFrame::OnToolBarSetGridSize, this);
@@ -827,15 +837,42 @@ namespace TrenchBroom {
                 copyToClipboard();
         }
 
+        /**
+         The clipboard data that refers to the nodes stored in the node clipboard of a process.
+         */
+        struct StoredNodesData {
+            unsigned long processId;
+            NodeClipboard::Id id;
+        };
+        
+        static const wxDataFormat& storedNodesFormat() {
+            static const wxDataFormat Format("TrenchBroom.StoredNodes");
+            return Format;
+        }
+        
         void MapFrame::copyToClipboard() {
             OpenClipboard openClipboard;
             if (wxTheClipboard->IsOpened()) {
-                String str;
-                if (m_document->hasSelectedNodes())
-                    str = m_document->serializeSelectedNodes();
-                else if (m_document->hasSelectedBrushFaces())
-                    str = m_document->serializeSelectedBrushFaces();
-                wxTheClipboard->SetData(new wxTextDataObject(str));
+                if (m_document->hasSelectedNodes()) {
+                    // the text is still needed to paste into other processes
+                    const String str = m_document->serializeSelectedNodes();
+                    
+                    StoredNodesData data;
+                    data.processId = wxGetProcessId();
+                    data.id = NodeClipboard::instance().store(m_document.get(), m_document->cloneSelectedNodes());
+                    
+                    wxCustomDataObject* nodesData = new wxCustomDataObject(storedNodesFormat());
+                    nodesData->SetData(sizeof(data), &data);
+                    
+                    wxDataObjectComposite* composite = new wxDataObjectComposite();
+                    composite->Add(new wxTextDataObject(str), true);
+                    composite->Add(nodesData);
+                    wxTheClipboard->SetData(composite);
+                } else if (m_document->hasSelectedBrushFaces()) {
+                    wxTheClipboard->SetData(new wxTextDataObject(m_document->serializeSelectedBrushFaces()));
+                } else {
+                    wxTheClipboard->SetData(new wxTextDataObject(""));
+                }
             }
         }
 
@@ -867,6 +904,19 @@ namespace TrenchBroom {
                 return PT_Failed;
             }
 
+            if (wxTheClipboard->IsSupported(storedNodesFormat())) {
+                wxCustomDataObject nodesData(storedNodesFormat());
+                if (wxTheClipboard->GetData(nodesData) && nodesData.GetSize() == sizeof(StoredNodesData)) {
+                    StoredNodesData data;
+                    std::memcpy(&data, nodesData.GetData(), sizeof(data));
+                    
+                    // nodes that were copied from this document are cloned instead of parsed from the text
+                    const NodeClipboard& nodeClipboard = NodeClipboard::instance();
+                    if (data.processId == wxGetProcessId() && nodeClipboard.contains(data.id, m_document.get()))
+                        return m_document->paste(nodeClipboard.cloneNodes(m_document->worldBounds()));
+                }
+            }
+            
             wxTextDataObject textData;
             if (!wxTheClipboard->GetData(textData)) {
                 logger()->error("Could not get clipboard contents");
@@ -1232,6 +1282,37 @@ namespace TrenchBroom {
             m_document->printVertices();
         }
 
+        void MapFrame::OnDebugPrintMemoryStatistics(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            m_document->printMemoryStatistics();
+        }
+
+        void MapFrame::OnDebugToggleRenderProfile(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            PreferenceManager::instance().set(Preferences::ShowRenderProfile, !pref(Preferences::ShowRenderProfile));
+            PreferenceManager::instance().saveChanges();
+        }
+
+        void MapFrame::OnDebugExportRenderProfile(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            wxFileDialog saveDialog(this, "Export Render Profile", wxEmptyString, "profile.csv", "CSV files (*.csv)|*.csv", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+            if (saveDialog.ShowModal() == wxID_CANCEL)
+                return;
+            
+            const IO::Path path(saveDialog.GetPath().ToStdString());
+            std::ofstream stream(path.asString().c_str());
+            if (!stream.is_open()) {
+                logger()->error("Could not open " + path.asString());
+                return;
+            }
+            
+            m_contextManager->renderProfiler().writeCsv(stream);
+            logger()->info("Exported render profile to " + path.asString());
+        }
+
         void MapFrame::OnDebugCreateBrush(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
             
@@ -1545,12 +1626,18 @@ namespace TrenchBroom {
                     event.Enable(canLaunch());
                     break;
                 case CommandIds::Menu::DebugPrintVertices:
+                case CommandIds::Menu::DebugPrintMemoryStatistics:
+                case CommandIds::Menu::DebugExportRenderProfile:
                 case CommandIds::Menu::DebugCreateBrush:
                 case CommandIds::Menu::DebugCreateCube:
                 case CommandIds::Menu::DebugCopyJSShortcuts:
                 case CommandIds::Menu::DebugCrash:
                     event.Enable(true);
                     break;
+                case CommandIds::Menu::DebugToggleRenderProfile:
+                    event.Enable(true);
+                    event.Check(pref(Preferences::ShowRenderProfile));
+                    break;
                 case CommandIds::Menu::DebugClipWithFace:
                     event.Enable(m_document->selectedNodes().hasOnlyBrushes());
                     break;
@@ -1718,7 +1805,18 @@ namespace TrenchBroom {
         void MapFrame::OnAutosaveTimer(wxTimerEvent& event) {
             if (IsBeingDeleted()) return;
 
-            m_autosaver->triggerAutosave(logger());
+            m_autosaver->triggerAutosave();
+        }
+
+        void MapFrame::OnIdle(wxIdleEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            // deliver the notifications posted by worker threads, including those posted during delivery
+            NotificationQueue& queue = m_document->notificationQueue();
+            queue.drain();
+            if (queue.hasPending())
+                event.RequestMore();
+            event.Skip();
         }
     }
 }
@@ -217,6 +217,9 @@ namespace TrenchBroom {
             void OnRunLaunch(wxCommandEvent& event);
 
             void OnDebugPrintVertices(wxCommandEvent& event);
+            void OnDebugPrintMemoryStatistics(wxCommandEvent& event);
+            void OnDebugToggleRenderProfile(wxCommandEvent& event);
+            void OnDebugExportRenderProfile(wxCommandEvent& event);
             void OnDebugCreateBrush(wxCommandEvent& event);
             void OnDebugCreateCube(wxCommandEvent& event);
             void OnDebugClipBrush(wxCommandEvent& event);
@@ -262,6 +265,7 @@ namespace TrenchBroom {
         private: // other event handlers
             void OnClose(wxCloseEvent& event);
             void OnAutosaveTimer(wxTimerEvent& event);
+            void OnIdle(wxIdleEvent& event);
         };
     }
 }
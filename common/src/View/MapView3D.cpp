@@ -26,6 +26,7 @@
 #include "Model/BrushGeometry.h"
 #include "Model/Entity.h"
 #include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/HitQuery.h"
 #include "Model/PickResult.h"
 #include "Model/PointFile.h"
@@ -315,8 +316,11 @@ namespace TrenchBroom {
             if (HitTest(clientCoords) == wxHT_WINDOW_INSIDE) {
                 const Ray3f pickRay = m_camera.pickRay(clientCoords.x, clientCoords.y);
                 
+                // only the nearest pickable brush is needed, so the picking can skip everything behind it
                 const Model::EditorContext& editorContext = document->editorContext();
-                Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
+                Model::HitFilter* filter = new Model::HitFilterChain(new Model::ContextHitFilter(editorContext),
+                                                                     new Model::TypedHitFilter(Model::Brush::BrushHit));
+                Model::PickResult pickResult = Model::PickResult::nearest(editorContext, filter);
 
                 document->pick(Ray3(pickRay), pickResult);
                 const Model::Hit& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).first();
@@ -45,7 +45,9 @@
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/MapRenderer.h"
 #include "Renderer/RenderBatch.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderService.h"
+#include "Renderer/TextAnchor.h"
 #include "View/ActionManager.h"
 #include "View/Animation.h"
 #include "View/CameraAnimation.h"
@@ -64,6 +66,8 @@
 #include <wx/menu.h>
 
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iterator>
 
 namespace TrenchBroom {
@@ -860,20 +864,45 @@ namespace TrenchBroom {
             renderContext.setShowGrid(grid.visible());
             renderContext.setGridSize(grid.actualSize());
 
+            Renderer::RenderProfiler& profiler = renderProfiler();
+            profiler.setEnabled(pref(Preferences::ShowRenderProfile));
+            if (profiler.enabled()) {
+                renderContext.setProfiler(&profiler);
+                // RenderView releases the view under the same pointer when it is destroyed
+                profiler.beginFrame(static_cast<RenderView*>(this), profileViewName());
+            }
+
             setupGL(renderContext);
             setRenderOptions(renderContext);
 
             Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
 
-            doRenderGrid(renderContext, renderBatch);
-            doRenderMap(m_renderer, renderContext, renderBatch);
-            doRenderTools(m_toolBox, renderContext, renderBatch);
-            doRenderExtras(renderContext, renderBatch);
-            renderCoordinateSystem(renderContext, renderBatch);
-            renderPointFile(renderContext, renderBatch);
-            renderCompass(renderBatch);
-            
-            renderBatch.render(renderContext);
+            {
+                Renderer::ProfileSection section(renderContext, "Grid");
+                doRenderGrid(renderContext, renderBatch);
+            }
+            {
+                Renderer::ProfileSection section(renderContext, "Map");
+                doRenderMap(m_renderer, renderContext, renderBatch);
+            }
+            {
+                Renderer::ProfileSection section(renderContext, "Tools");
+                doRenderTools(m_toolBox, renderContext, renderBatch);
+            }
+            {
+                Renderer::ProfileSection section(renderContext, "Extras");
+                doRenderExtras(renderContext, renderBatch);
+                renderCoordinateSystem(renderContext, renderBatch);
+                renderPointFile(renderContext, renderBatch);
+                renderCompass(renderBatch);
+                renderProfile(renderContext, renderBatch);
+            }
+            {
+                Renderer::ProfileSection section(renderContext, "Batch");
+                renderBatch.render(renderContext);
+            }
+
+            profiler.endFrame();
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
@@ -910,6 +939,64 @@ namespace TrenchBroom {
             if (m_compass != NULL)
                 m_compass->render(renderBatch);
         }
+
+        class ProfileTextAnchor : public Renderer::TextAnchor {
+        private:
+            Vec3f offset(const Renderer::Camera& camera, const Vec2f& size) const {
+                const Vec3f off = getOffset(camera);
+                return Vec3f(off.x(), off.y() - size.y(), off.z());
+            }
+            
+            Vec3f position(const Renderer::Camera& camera) const {
+                return camera.unproject(getOffset(camera));
+            }
+            
+            Vec3f getOffset(const Renderer::Camera& camera) const {
+                const float h(camera.unzoomedViewport().height);
+                return Vec3f(10.0f, h - 10.0f, 0.0f);
+            }
+        };
+
+        void MapViewBase::renderProfile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            const Renderer::RenderProfiler* profiler = renderContext.profiler();
+            if (profiler == NULL)
+                return;
+            
+            // the profile of this frame is not available until the next frame has been rendered
+            const Renderer::RenderProfiler::Frame* frame = profiler->lastFrame(profileViewName());
+            if (frame == NULL)
+                return;
+            
+            AttrString string;
+            for (const Renderer::RenderProfiler::Section& section : frame->sections) {
+                StringStream line;
+                line << std::fixed << std::setprecision(2);
+                line << String(2 * section.depth, ' ') << section.name << ": " << section.cpuTime << " ms CPU";
+                if (!std::isnan(section.gpuTime))
+                    line << ", " << section.gpuTime << " ms GPU";
+                line << ", " << section.drawCalls << " draws, " << section.uploadBytes / 1024 << " KiB";
+                string.appendLeftJustified(line.str());
+            }
+            
+            Renderer::RenderService renderService(renderContext, renderBatch);
+            renderService.setForegroundColor(pref(Preferences::InfoOverlayTextColor));
+            renderService.setBackgroundColor(pref(Preferences::InfoOverlayBackgroundColor));
+            renderService.renderString(string, ProfileTextAnchor());
+        }
+
+        String MapViewBase::profileViewName() {
+            if (doGetRenderMode() == Renderer::RenderContext::RenderMode_3D)
+                return "3D";
+            
+            switch (doGetCamera().direction().firstComponent()) {
+                case Math::Axis::AX:
+                    return "YZ";
+                case Math::Axis::AY:
+                    return "XZ";
+                default:
+                    return "XY";
+            }
+        }
         
         static bool isEntity(const Model::Node* node) {
             class IsEntity : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
@@ -205,6 +205,8 @@ namespace TrenchBroom {
             void renderCoordinateSystem(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderPointFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderCompass(Renderer::RenderBatch& renderBatch);
+            void renderProfile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
+            String profileViewName();
         private: // implement ToolBoxConnector
             void doShowPopupMenu();
             wxMenu* makeEntityGroupsMenu(Assets::EntityDefinition::Type type, int id);
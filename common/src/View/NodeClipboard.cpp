@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeClipboard.h"
+
+#include "CollectionUtils.h"
+#include "Model/Node.h"
+
+namespace TrenchBroom {
+    namespace View {
+        NodeClipboard::NodeClipboard() :
+        m_id(NoId),
+        m_document(NULL) {}
+        
+        NodeClipboard::~NodeClipboard() {
+            clear();
+        }
+        
+        NodeClipboard& NodeClipboard::instance() {
+            static NodeClipboard Instance;
+            return Instance;
+        }
+        
+        NodeClipboard::Id NodeClipboard::store(const MapDocument* document, const Model::NodeList& nodes) {
+            static Id LastId = NoId;
+            
+            clear();
+            m_id = ++LastId;
+            m_document = document;
+            m_nodes = nodes;
+            return m_id;
+        }
+        
+        bool NodeClipboard::contains(const Id id, const MapDocument* document) const {
+            return id != NoId && id == m_id && document == m_document;
+        }
+        
+        Model::NodeList NodeClipboard::cloneNodes(const BBox3& worldBounds) const {
+            Model::NodeList result;
+            result.reserve(m_nodes.size());
+            for (const Model::Node* node : m_nodes)
+                result.push_back(node->cloneRecursively(worldBounds));
+            return result;
+        }
+        
+        void NodeClipboard::clear() {
+            VectorUtils::clearAndDelete(m_nodes);
+            m_id = NoId;
+            m_document = NULL;
+        }
+        
+        void NodeClipboard::clear(const MapDocument* document) {
+            if (document == m_document)
+                clear();
+        }
+    }
+}
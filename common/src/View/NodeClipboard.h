@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_NodeClipboard
+#define TrenchBroom_NodeClipboard
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "Model/ModelTypes.h"
+
+namespace TrenchBroom {
+    namespace View {
+        class MapDocument;
+        
+        /**
+         Keeps clones of the nodes that were last copied to the system clipboard. The system clipboard only holds the
+         ID of the stored nodes next to their serialized text, so that pasting them into the document they were copied
+         from can clone the stored nodes instead of parsing the text and building the brush geometry again.
+         
+         The stored nodes must not refer to any textures or entity definitions, since these belong to the document and
+         may be unloaded while the nodes are stored.
+         */
+        class NodeClipboard {
+        public:
+            typedef size_t Id;
+            static const Id NoId = 0;
+        private:
+            Id m_id;
+            const MapDocument* m_document;
+            Model::NodeList m_nodes;
+        public:
+            NodeClipboard();
+            ~NodeClipboard();
+            
+            static NodeClipboard& instance();
+            
+            /**
+             Replaces the stored nodes with the given nodes, which were copied from the given document and must not
+             have a parent, and takes ownership of them. Returns the ID of the stored nodes.
+             */
+            Id store(const MapDocument* document, const Model::NodeList& nodes);
+            
+            /**
+             Indicates whether the nodes with the given ID are stored and were copied from the given document.
+             */
+            bool contains(Id id, const MapDocument* document) const;
+            
+            /**
+             Returns recursive clones of the stored nodes. The caller takes ownership of the clones.
+             */
+            Model::NodeList cloneNodes(const BBox3& worldBounds) const;
+            
+            void clear();
+            
+            /**
+             Clears the stored nodes if they were copied from the given document.
+             */
+            void clear(const MapDocument* document);
+        private:
+            NodeClipboard(const NodeClipboard& other);
+            NodeClipboard& operator=(const NodeClipboard& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_NodeClipboard) */
@@ -21,6 +21,7 @@
 #include "Exceptions.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Transformation.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/VertexSpec.h"
@@ -46,7 +47,11 @@ namespace TrenchBroom {
             bindEvents();
         }
         
-        RenderView::~RenderView() {}
+        RenderView::~RenderView() {
+            // the profiler's query objects belong to the context of this view
+            const bool contextCurrent = m_glContext->SetCurrent(this);
+            renderProfiler().releaseView(this, contextCurrent);
+        }
         
         void RenderView::OnPaint(wxPaintEvent& event) {
             if (IsBeingDeleted()) return;
@@ -99,6 +104,10 @@ namespace TrenchBroom {
             return m_glContext->shaderManager();
         }
 
+        Renderer::RenderProfiler& RenderView::renderProfiler() {
+            return m_glContext->renderProfiler();
+        }
+
         int RenderView::depthBits() const {
             return GLAttribs::depth();
         }
@@ -57,5 +57,12 @@ namespace TrenchBroom {
         bool ReparentNodesCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+        
+        size_t ReparentNodesCommand::doGetMemoryUsage() const {
+            // the nodes remain in the document, only their parents change
+            return (sizeof(ReparentNodesCommand) +
+                    Model::estimateReferenceMemoryUsage(m_nodesToAdd) +
+                    Model::estimateReferenceMemoryUsage(m_nodesToRemove));
+        }
     }
 }
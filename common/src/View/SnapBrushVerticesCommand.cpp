@@ -65,5 +65,12 @@ namespace TrenchBroom {
             SnapBrushVerticesCommand* other = static_cast<SnapBrushVerticesCommand*>(command.get());
             return other->m_snapTo == m_snapTo;
         }
+
+        size_t SnapBrushVerticesCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(SnapBrushVerticesCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
@@ -52,10 +52,13 @@ namespace TrenchBroom {
         m_action(action),
         m_transform(transform),
         m_lockTextures(lockTextures),
-        m_snapshot(NULL) {}
+        m_snapshot(NULL),
+        m_collating(false) {}
         
         bool TransformObjectsCommand::doPerformDo(MapDocumentCommandFacade* document) {
-            takeSnapshot(document->selectedNodes().nodes());
+            // when dragging, only the first command of the drag needs a snapshot, the others are merged into it
+            if (!m_collating)
+                takeSnapshot(document->selectedNodes().nodes());
             document->performTransform(m_transform, m_lockTextures);
             return true;
         }
@@ -86,13 +89,32 @@ namespace TrenchBroom {
         }
         
         bool TransformObjectsCommand::doCollateWith(UndoableCommand::Ptr command) {
+            if (!doCanCollateWith(command))
+                return false;
+            
             TransformObjectsCommand* other = static_cast<TransformObjectsCommand*>(command.get());
+            m_transform = m_transform * other->m_transform;
+            return true;
+        }
+        
+        bool TransformObjectsCommand::doCanCollateWith(UndoableCommand::Ptr command) const {
+            const TransformObjectsCommand* other = static_cast<const TransformObjectsCommand*>(command.get());
             if (other->m_lockTextures != m_lockTextures)
                 return false;
             if (other->m_action != m_action)
                 return false;
-            m_transform = m_transform * other->m_transform;
             return true;
         }
+        
+        void TransformObjectsCommand::doPrepareForCollation() {
+            m_collating = true;
+        }
+
+        size_t TransformObjectsCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(TransformObjectsCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
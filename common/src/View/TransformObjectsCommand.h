@@ -50,6 +50,7 @@ namespace TrenchBroom {
             bool m_lockTextures;
             
             Model::Snapshot* m_snapshot;
+            bool m_collating;
         public:
             static Ptr translate(const Vec3& delta, bool lockTextures);
             static Ptr rotate(const Vec3& center, const Vec3& axis, FloatType angle, bool lockTextures);
@@ -68,6 +69,9 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             bool doCollateWith(UndoableCommand::Ptr command);
+            bool doCanCollateWith(UndoableCommand::Ptr command) const;
+            void doPrepareForCollation();
+            size_t doGetMemoryUsage() const;
         };
     }
 }
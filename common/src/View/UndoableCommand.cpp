@@ -58,6 +58,21 @@ namespace TrenchBroom {
             return doCollateWith(command);
         }
 
+        bool UndoableCommand::canCollateWith(UndoableCommand::Ptr command) const {
+            assert(command.get() != this);
+            if (command->type() != m_type)
+                return false;
+            return doCanCollateWith(command);
+        }
+        
+        void UndoableCommand::prepareForCollation() {
+            doPrepareForCollation();
+        }
+
+        size_t UndoableCommand::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+
         bool UndoableCommand::doIsRepeatDelimiter() const {
             return false;
         }
@@ -66,6 +81,16 @@ namespace TrenchBroom {
             throw CommandProcessorException("Command is not repeatable");
         }
 
+        bool UndoableCommand::doCanCollateWith(UndoableCommand::Ptr command) const {
+            return false;
+        }
+        
+        void UndoableCommand::doPrepareForCollation() {}
+
+        size_t UndoableCommand::doGetMemoryUsage() const {
+            return sizeof(UndoableCommand);
+        }
+
         size_t UndoableCommand::documentModificationCount() const {
             throw CommandProcessorException("Command does not modify the document");
         }
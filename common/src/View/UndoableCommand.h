@@ -41,6 +41,23 @@ namespace TrenchBroom {
             UndoableCommand::Ptr repeat(MapDocumentCommandFacade* document) const;
             
             virtual bool collateWith(UndoableCommand::Ptr command);
+            
+            /**
+             Returns whether collating the given command with this command will succeed. If it returns true, the given
+             command may be prepared for collation before it is performed, and collateWith must not fail afterwards.
+             */
+            bool canCollateWith(UndoableCommand::Ptr command) const;
+            
+            /**
+             Called before a command is performed if it will be merged into a previous command. Such a command is never
+             undone, so it need not record any undo information.
+             */
+            void prepareForCollation();
+            
+            /**
+             Returns an estimate of the number of bytes that this command occupies, including any snapshots it holds.
+             */
+            size_t memoryUsage() const;
         private:
             virtual bool doPerformUndo(MapDocumentCommandFacade* document) = 0;
             
@@ -49,6 +66,10 @@ namespace TrenchBroom {
             virtual UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             virtual bool doCollateWith(UndoableCommand::Ptr command) = 0;
+            virtual bool doCanCollateWith(UndoableCommand::Ptr command) const;
+            virtual void doPrepareForCollation();
+            
+            virtual size_t doGetMemoryUsage() const;
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
         private:
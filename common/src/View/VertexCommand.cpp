@@ -166,5 +166,12 @@ namespace TrenchBroom {
         void VertexCommand::selectOldHandlePositions(VertexHandleManager& manager) {
             doSelectOldHandlePositions(manager, m_brushes);
         }
+
+        size_t VertexCommand::doGetMemoryUsage() const {
+            size_t result = sizeof(VertexCommand);
+            if (m_snapshot != NULL)
+                result += m_snapshot->memoryUsage();
+            return result;
+        }
     }
 }
@@ -49,6 +49,7 @@ namespace TrenchBroom {
             bool doPerformDo(MapDocumentCommandFacade* document);
             bool doPerformUndo(MapDocumentCommandFacade* document);
             bool doIsRepeatable(MapDocumentCommandFacade* document) const;
+            size_t doGetMemoryUsage() const;
         private:
             void takeSnapshot();
             void deleteSnapshot();
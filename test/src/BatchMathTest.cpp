@@ -0,0 +1,292 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BatchMath.h"
+#include "MathUtils.h"
+#include "VecMath.h"
+#include "TestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+template <typename T>
+static T randomValue(const T min, const T max) {
+    return min + static_cast<T>(std::rand()) / static_cast<T>(RAND_MAX) * (max - min);
+}
+
+template <typename T>
+static Vec<T,3> randomPoint(const T range) {
+    return Vec<T,3>(randomValue(-range, range), randomValue(-range, range), randomValue(-range, range));
+}
+
+template <typename T>
+static typename Vec<T,3>::List randomPoints(const size_t count, const T range) {
+    typename Vec<T,3>::List result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        result.push_back(randomPoint(range));
+    return result;
+}
+
+template <typename T>
+static std::vector<BBox<T,3> > randomBoxes(const size_t count, const T range, const T maxSize) {
+    std::vector<BBox<T,3> > result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vec<T,3> min = randomPoint(range);
+        const Vec<T,3> size(randomValue(static_cast<T>(0.0), maxSize), randomValue(static_cast<T>(0.0), maxSize), randomValue(static_cast<T>(0.0), maxSize));
+        result.push_back(BBox<T,3>(min, min + size));
+    }
+    return result;
+}
+
+template <typename T>
+static Mat<T,4,4> randomTransform() {
+    return translationMatrix(randomPoint(static_cast<T>(512.0))) *
+           rotationMatrix(randomValue(static_cast<T>(0.0), Math::Constants<T>::twoPi()),
+                          randomValue(static_cast<T>(0.0), Math::Constants<T>::twoPi()),
+                          randomValue(static_cast<T>(0.0), Math::Constants<T>::twoPi())) *
+           scalingMatrix(Vec<T,3>(randomValue(static_cast<T>(0.5), static_cast<T>(2.0)),
+                                  randomValue(static_cast<T>(0.5), static_cast<T>(2.0)),
+                                  randomValue(static_cast<T>(0.5), static_cast<T>(2.0))));
+}
+
+template <typename T>
+static Mat<T,4,4> scalarProduct(const Mat<T,4,4>& lhs, const Mat<T,4,4>& rhs) {
+    Mat<T,4,4> result(Mat<T,4,4>::Null);
+    for (size_t c = 0; c < 4; c++)
+        for (size_t r = 0; r < 4; r++)
+            for (size_t i = 0; i < 4; ++i)
+                result[c][r] += lhs[i][r] * rhs[c][i];
+    return result;
+}
+
+template <typename T>
+static void testMatrixProduct() {
+    for (size_t i = 0; i < 100; ++i) {
+        const Mat<T,4,4> lhs = randomTransform<T>();
+        const Mat<T,4,4> rhs = randomTransform<T>();
+        ASSERT_TRUE(scalarProduct(lhs, rhs) == lhs * rhs);
+    }
+}
+
+TEST(BatchMathTest, matrixProductFloat) {
+    testMatrixProduct<float>();
+}
+
+TEST(BatchMathTest, matrixProductDouble) {
+    testMatrixProduct<double>();
+}
+
+template <typename T>
+static void testTransformPoints() {
+    const Mat<T,4,4> transform = randomTransform<T>();
+    const typename Vec<T,3>::List points = randomPoints<T>(1000, static_cast<T>(4096.0));
+
+    typename Vec<T,3>::List scalar(points.size()), batch(points.size());
+    BatchMath::Scalar::transformPoints(transform, &points.front(), points.size(), &scalar.front());
+    BatchMath::transformPoints(transform, &points.front(), points.size(), &batch.front());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_TRUE(scalar[i] == batch[i]);
+        ASSERT_TRUE(scalar[i] == transform * points[i]);
+    }
+}
+
+TEST(BatchMathTest, transformPointsFloat) {
+    testTransformPoints<float>();
+}
+
+TEST(BatchMathTest, transformPointsDouble) {
+    testTransformPoints<double>();
+}
+
+template <typename T>
+static void testComputeAndMergeBounds() {
+    const typename Vec<T,3>::List points = randomPoints<T>(1001, static_cast<T>(4096.0));
+    const BBox<T,3> expected(points);
+    ASSERT_EQ(expected, BatchMath::Scalar::computeBounds(&points.front(), points.size()));
+    ASSERT_EQ(expected, BatchMath::computeBounds(points));
+
+    const std::vector<BBox<T,3> > boxes = randomBoxes<T>(1001, static_cast<T>(4096.0), static_cast<T>(256.0));
+    BBox<T,3> merged = boxes.front();
+    for (size_t i = 1; i < boxes.size(); ++i)
+        merged.mergeWith(boxes[i]);
+    ASSERT_EQ(merged, BatchMath::Scalar::mergeBounds(&boxes.front(), boxes.size()));
+    ASSERT_EQ(merged, BatchMath::mergeBounds(&boxes.front(), boxes.size()));
+}
+
+TEST(BatchMathTest, computeAndMergeBoundsFloat) {
+    testComputeAndMergeBounds<float>();
+}
+
+TEST(BatchMathTest, computeAndMergeBoundsDouble) {
+    testComputeAndMergeBounds<double>();
+}
+
+template <typename T>
+static void testIntersectsAndContains() {
+    const BBox<T,3> bounds(Vec<T,3>(-512.0, -256.0, -128.0), Vec<T,3>(512.0, 256.0, 128.0));
+    const std::vector<BBox<T,3> > boxes = randomBoxes<T>(1000, static_cast<T>(1024.0), static_cast<T>(256.0));
+    const typename Vec<T,3>::List points = randomPoints<T>(1000, static_cast<T>(1024.0));
+
+    bool intersects[1000], contains[1000];
+    BatchMath::intersectsBounds(bounds, &boxes.front(), boxes.size(), intersects);
+    BatchMath::containsPoints(bounds, &points.front(), points.size(), contains);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(bounds.intersects(boxes[i]), intersects[i]);
+        ASSERT_EQ(bounds.contains(points[i]), contains[i]);
+    }
+}
+
+TEST(BatchMathTest, intersectsAndContainsFloat) {
+    testIntersectsAndContains<float>();
+}
+
+TEST(BatchMathTest, intersectsAndContainsDouble) {
+    testIntersectsAndContains<double>();
+}
+
+template <typename T>
+static void testIntersectBoundsWithRay(const Ray<T,3>& ray) {
+    const std::vector<BBox<T,3> > boxes = randomBoxes<T>(1000, static_cast<T>(1024.0), static_cast<T>(512.0));
+
+    std::vector<T> scalar(boxes.size()), batch(boxes.size());
+    const size_t scalarHits = BatchMath::Scalar::intersectBoundsWithRay(ray, &boxes.front(), boxes.size(), &scalar.front());
+    const size_t batchHits = BatchMath::intersectBoundsWithRay(ray, &boxes.front(), boxes.size(), &batch.front());
+    ASSERT_EQ(scalarHits, batchHits);
+
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const T expected = boxes[i].intersectWithRay(ray);
+        ASSERT_EQ(Math::isnan(expected), Math::isnan(scalar[i]));
+        ASSERT_EQ(Math::isnan(expected), Math::isnan(batch[i]));
+        if (!Math::isnan(expected)) {
+            ASSERT_NEAR(expected, scalar[i], static_cast<T>(0.01));
+            ASSERT_EQ(scalar[i], batch[i]);
+        }
+    }
+}
+
+TEST(BatchMathTest, intersectBoundsWithRayFloat) {
+    testIntersectBoundsWithRay(Ray3f(Vec3f(-2048.0f, -1500.0f, 0.0f), Vec3f(1.0f, 0.7f, 0.1f).normalized()));
+    testIntersectBoundsWithRay(Ray3f(Vec3f(0.0f, 0.0f, 0.0f), Vec3f(1.0f, -0.3f, 0.2f).normalized()));
+    testIntersectBoundsWithRay(Ray3f(Vec3f(-2048.0f, 0.0f, 0.0f), Vec3f::PosX));
+    testIntersectBoundsWithRay(Ray3f(Vec3f(0.0f, 0.0f, 2048.0f), Vec3f::NegZ));
+}
+
+TEST(BatchMathTest, intersectBoundsWithRayDouble) {
+    testIntersectBoundsWithRay(Ray3d(Vec3d(-2048.0, -1500.0, 0.0), Vec3d(1.0, 0.7, 0.1).normalized()));
+    testIntersectBoundsWithRay(Ray3d(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, -0.3, 0.2).normalized()));
+    testIntersectBoundsWithRay(Ray3d(Vec3d(-2048.0, 0.0, 0.0), Vec3d::PosX));
+    testIntersectBoundsWithRay(Ray3d(Vec3d(0.0, 0.0, 2048.0), Vec3d::NegZ));
+}
+
+template <typename T>
+static void testPointDistances() {
+    const Plane<T,3> plane(static_cast<T>(12.0), Vec<T,3>(1.0, 2.0, -3.0).normalized());
+    const typename Vec<T,3>::List points = randomPoints<T>(1000, static_cast<T>(4096.0));
+
+    std::vector<T> distances(points.size());
+    BatchMath::pointDistances(plane, &points.front(), points.size(), &distances.front());
+    for (size_t i = 0; i < points.size(); ++i)
+        ASSERT_EQ(plane.pointDistance(points[i]), distances[i]);
+}
+
+TEST(BatchMathTest, pointDistancesFloat) {
+    testPointDistances<float>();
+}
+
+TEST(BatchMathTest, pointDistancesDouble) {
+    testPointDistances<double>();
+}
+
+/*
+ The following benchmarks compare the throughput of the scalar and the SIMD implementations. They are disabled by
+ default; run them with --gtest_also_run_disabled_tests --gtest_filter=BatchMathBenchmark.*
+ */
+
+template <typename F>
+static double measure(const size_t repetitions, F f) {
+    typedef std::chrono::high_resolution_clock Clock;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < repetitions; ++i)
+        f();
+    const Clock::time_point end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void printBenchmark(const String& name, const size_t items, const double scalarMs, const double batchMs) {
+    std::cout << name << ": " << items << " items, scalar " << scalarMs << "ms, batch " << batchMs << "ms, speedup " << scalarMs / batchMs << std::endl;
+}
+
+template <typename T>
+static void benchmarkBatchMath(const String& type) {
+    const size_t count = 100000;
+    const size_t repetitions = 100;
+
+    const Mat<T,4,4> transform = randomTransform<T>();
+    const typename Vec<T,3>::List points = randomPoints<T>(count, static_cast<T>(4096.0));
+    const std::vector<BBox<T,3> > boxes = randomBoxes<T>(count, static_cast<T>(4096.0), static_cast<T>(256.0));
+    const Ray<T,3> ray(Vec<T,3>(-8192.0, -6000.0, 0.0), Vec<T,3>(1.0, 0.7, 0.1).normalized());
+    const BBox<T,3> bounds(Vec<T,3>(-512.0, -256.0, -128.0), Vec<T,3>(512.0, 256.0, 128.0));
+
+    typename Vec<T,3>::List transformed(count);
+    BBox<T,3> sink;
+    Mat<T,4,4> product;
+    std::vector<T> distances(count);
+    std::unique_ptr<bool[]> flags(new bool[count]);
+    bool* flagsPtr = flags.get();
+
+    printBenchmark(type + " transformPoints", count,
+                   measure(repetitions, [&]() { BatchMath::Scalar::transformPoints(transform, &points.front(), count, &transformed.front()); }),
+                   measure(repetitions, [&]() { BatchMath::transformPoints(transform, &points.front(), count, &transformed.front()); }));
+    printBenchmark(type + " computeBounds", count,
+                   measure(repetitions, [&]() { sink = BatchMath::Scalar::computeBounds(&points.front(), count); }),
+                   measure(repetitions, [&]() { sink = BatchMath::computeBounds(&points.front(), count); }));
+    printBenchmark(type + " mergeBounds", count,
+                   measure(repetitions, [&]() { sink = BatchMath::Scalar::mergeBounds(&boxes.front(), count); }),
+                   measure(repetitions, [&]() { sink = BatchMath::mergeBounds(&boxes.front(), count); }));
+    printBenchmark(type + " intersectsBounds", count,
+                   measure(repetitions, [&]() { BatchMath::Scalar::intersectsBounds(bounds, &boxes.front(), count, flagsPtr); }),
+                   measure(repetitions, [&]() { BatchMath::intersectsBounds(bounds, &boxes.front(), count, flagsPtr); }));
+    printBenchmark(type + " intersectBoundsWithRay", count,
+                   measure(repetitions, [&]() { BatchMath::Scalar::intersectBoundsWithRay(ray, &boxes.front(), count, &distances.front()); }),
+                   measure(repetitions, [&]() { BatchMath::intersectBoundsWithRay(ray, &boxes.front(), count, &distances.front()); }));
+    printBenchmark(type + " matrix product", count,
+                   measure(repetitions, [&]() { for (size_t i = 0; i < count / 100; ++i) product = scalarProduct(product, transform); }),
+                   measure(repetitions, [&]() { for (size_t i = 0; i < count / 100; ++i) product = product * transform; }));
+
+    // make sure that the results are used so that the compiler cannot remove the computations
+    ASSERT_FALSE(sink.min.nan());
+    ASSERT_FALSE(transformed.front().nan() && product[0].nan());
+}
+
+TEST(BatchMathBenchmark, DISABLED_float) {
+    benchmarkBatchMath<float>("float");
+}
+
+TEST(BatchMathBenchmark, DISABLED_double) {
+    benchmarkBatchMath<double>("double");
+}
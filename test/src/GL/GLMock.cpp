@@ -20,7 +20,8 @@
 #include "GLMock.h"
 
 namespace TrenchBroom {
-    GLMock::GLMock() {
+    GLMock::GLMock() :
+    m_extensions(NULL) {
         glewInitialize.bindMemFunc(this, &GLMock::GlewInitialize);
 
         glGetError.bindMemFunc(this, &GLMock::GetError);
@@ -138,6 +139,11 @@ namespace TrenchBroom {
         glUniformMatrix4x3fv.bindMemFunc(this, &GLMock::UniformMatrix4x3fv);
         
         glGetUniformLocation.bindMemFunc(this, &GLMock::GetUniformLocation);
+
+        glGenQueries.bindMemFunc(this, &GLMock::GenQueries);
+        glDeleteQueries.bindMemFunc(this, &GLMock::DeleteQueries);
+        glQueryCounter.bindMemFunc(this, &GLMock::QueryCounter);
+        glGetQueryObjectui64v.bindMemFunc(this, &GLMock::GetQueryObjectui64v);
         
 #ifdef __APPLE__
         glFinishObjectAPPLE.bindMemFunc(this, &GLMock::FinishObjectAPPLE);
@@ -27,9 +27,12 @@
 
 namespace TrenchBroom {
     class GLMock {
+    private:
+        const char* m_extensions;
     public:
         GLenum GetError() { return GL_NO_ERROR; }
-        const GLubyte* GetString(GLenum) { return NULL; }
+        const GLubyte* GetString(GLenum name) { return name == GL_EXTENSIONS ? reinterpret_cast<const GLubyte*>(m_extensions) : NULL; }
+        void setExtensions(const char* extensions) { m_extensions = extensions; }
         
         MOCK_METHOD0(GlewInitialize, void());
         
@@ -145,6 +148,11 @@ namespace TrenchBroom {
         MOCK_METHOD4(UniformMatrix4x3fv, void(GLint, GLsizei, GLboolean, const GLfloat*));
         
         MOCK_METHOD2(GetUniformLocation, GLint(GLuint, const GLchar*));
+
+        MOCK_METHOD2(GenQueries, void(GLsizei, GLuint*));
+        MOCK_METHOD2(DeleteQueries, void(GLsizei, const GLuint*));
+        MOCK_METHOD2(QueryCounter, void(GLuint, GLenum));
+        MOCK_METHOD3(GetQueryObjectui64v, void(GLuint, GLenum, GLuint64*));
         
 #ifdef __APPLE__
         void FinishObjectAPPLE(GLenum, GLint) {}
@@ -843,6 +843,14 @@ TEST(MatTest, translationMatrix) {
     ASSERT_VEC_EQ(t[3], Vec4d(v, 1.0));
 }
 
+TEST(MatTest, isTranslationMatrix) {
+    ASSERT_TRUE(isTranslationMatrix(Mat4x4d::Identity));
+    ASSERT_TRUE(isTranslationMatrix(translationMatrix(Vec3d(2.0, 3.0, 4.0))));
+    ASSERT_FALSE(isTranslationMatrix(scalingMatrix(Vec3d(2.0, 3.0, 4.0))));
+    ASSERT_FALSE(isTranslationMatrix(rotationMatrix(Vec3d::PosZ, Math::radians(15.0))));
+    ASSERT_FALSE(isTranslationMatrix(translationMatrix(Vec3d(2.0, 3.0, 4.0)) * Mat4x4d::MirX));
+}
+
 TEST(MatTest, scalingMatrix) {
     const Vec3d v(2.0, 3.0, 4.0);
     const Mat4x4d t = scalingMatrix(v);
@@ -0,0 +1,233 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "VecMath.h"
+#include "Model/AABBTree.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        typedef AABBTree<double, size_t> Tree;
+
+        static std::vector<BBox3d> makeBoxes(const size_t count) {
+            // a deterministic mix of small and large boxes
+            std::vector<BBox3d> result;
+            unsigned int seed = 1;
+            const auto next = [&seed]() {
+                seed = seed * 1103515245u + 12345u;
+                return static_cast<double>((seed >> 8) % 8192) - 4096.0;
+            };
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vec3d center(next(), next(), next());
+                const double size = i % 10 == 0 ? 1024.0 : 32.0;
+                result.push_back(BBox3d(center - Vec3d(size, size, size), center + Vec3d(size, size, size)));
+            }
+            return result;
+        }
+
+        static std::vector<size_t> bruteForce(const std::vector<BBox3d>& boxes, const std::vector<bool>& present, const Ray3d& ray) {
+            std::vector<size_t> result;
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                if (present[i] && !Math::isnan(boxes[i].intersectWithRay(ray)))
+                    result.push_back(i);
+            }
+            return result;
+        }
+
+        static std::vector<size_t> sorted(std::vector<size_t> objects) {
+            std::sort(std::begin(objects), std::end(objects));
+            return objects;
+        }
+
+        TEST(AABBTreeTest, insertAndRemoveObjects) {
+            Tree tree;
+            ASSERT_TRUE(tree.empty());
+
+            tree.addObject(BBox3d(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 1.0, 1.0)), 1);
+            tree.addObject(BBox3d(Vec3d(2.0, 0.0, 0.0), Vec3d(3.0, 1.0, 1.0)), 2);
+            tree.addObject(BBox3d(Vec3d(-4.0, 0.0, 0.0), Vec3d(-3.0, 1.0, 1.0)), 3);
+            ASSERT_EQ(3u, tree.size());
+            ASSERT_TRUE(tree.containsObject(2));
+            ASSERT_EQ(BBox3d(Vec3d(-4.0, 0.0, 0.0), Vec3d(3.0, 1.0, 1.0)), tree.bounds());
+            ASSERT_THROW(tree.addObject(BBox3d(0.0, 1.0), 2), AABBTreeException);
+
+            tree.removeObject(3);
+            ASSERT_FALSE(tree.containsObject(3));
+            ASSERT_EQ(BBox3d(Vec3d(0.0, 0.0, 0.0), Vec3d(3.0, 1.0, 1.0)), tree.bounds());
+            ASSERT_THROW(tree.removeObject(3), AABBTreeException);
+
+            tree.removeObject(1);
+            tree.removeObject(2);
+            ASSERT_TRUE(tree.empty());
+        }
+
+        TEST(AABBTreeTest, updateObject) {
+            Tree tree;
+            tree.addObject(BBox3d(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 1.0, 1.0)), 1);
+            tree.addObject(BBox3d(Vec3d(2.0, 0.0, 0.0), Vec3d(3.0, 1.0, 1.0)), 2);
+
+            // stays within its parent
+            tree.updateObject(BBox3d(Vec3d(1.0, 0.0, 0.0), Vec3d(2.0, 1.0, 1.0)), 1);
+            ASSERT_EQ(BBox3d(Vec3d(1.0, 0.0, 0.0), Vec3d(3.0, 1.0, 1.0)), tree.bounds());
+
+            // leaves its parent
+            tree.updateObject(BBox3d(Vec3d(10.0, 0.0, 0.0), Vec3d(11.0, 1.0, 1.0)), 1);
+            ASSERT_EQ(BBox3d(Vec3d(2.0, 0.0, 0.0), Vec3d(11.0, 1.0, 1.0)), tree.bounds());
+            ASSERT_EQ(std::vector<size_t>(1, 1), tree.findObjects(Vec3d(10.5, 0.5, 0.5)));
+
+            ASSERT_THROW(tree.updateObject(BBox3d(0.0, 1.0), 3), AABBTreeException);
+        }
+
+        TEST(AABBTreeTest, updateObjectWithinMargin) {
+            Tree tree(2.0);
+            tree.addObject(BBox3d(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 1.0, 1.0)), 1);
+            tree.addObject(BBox3d(Vec3d(4.0, 0.0, 0.0), Vec3d(5.0, 1.0, 1.0)), 2);
+            const BBox3d bounds(Vec3d(-2.0, -2.0, -2.0), Vec3d(7.0, 3.0, 3.0));
+            ASSERT_EQ(bounds, tree.bounds());
+
+            // small moves do not change the tree
+            tree.updateObject(BBox3d(Vec3d(1.5, 0.0, 0.0), Vec3d(2.5, 1.0, 1.0)), 1);
+            ASSERT_EQ(bounds, tree.bounds());
+            ASSERT_EQ(std::vector<size_t>(1, 1), tree.findObjects(Vec3d(-1.0, 0.5, 0.5)));
+
+            // leaving the enlarged bounds does
+            tree.updateObject(BBox3d(Vec3d(10.0, 0.0, 0.0), Vec3d(11.0, 1.0, 1.0)), 1);
+            ASSERT_EQ(BBox3d(Vec3d(2.0, -2.0, -2.0), Vec3d(13.0, 3.0, 3.0)), tree.bounds());
+
+            // and so does shrinking a lot
+            tree.updateObject(BBox3d(Vec3d(10.0, 0.0, 0.0), Vec3d(20.0, 10.0, 10.0)), 2);
+            ASSERT_EQ(BBox3d(Vec3d(8.0, -2.0, -2.0), Vec3d(22.0, 12.0, 12.0)), tree.bounds());
+            tree.updateObject(BBox3d(Vec3d(10.0, 0.0, 0.0), Vec3d(11.0, 1.0, 1.0)), 2);
+            ASSERT_EQ(BBox3d(Vec3d(8.0, -2.0, -2.0), Vec3d(13.0, 3.0, 3.0)), tree.bounds());
+        }
+
+        TEST(AABBTreeTest, findObjectsMatchesBruteForce) {
+            const std::vector<BBox3d> boxes = makeBoxes(1000);
+            std::vector<bool> present(boxes.size(), true);
+
+            Tree tree;
+            for (size_t i = 0; i < boxes.size(); ++i)
+                tree.addObject(boxes[i], i);
+
+            // remove and move some objects to exercise the incremental updates
+            std::vector<BBox3d> current = boxes;
+            for (size_t i = 0; i < boxes.size(); i += 7) {
+                tree.removeObject(i);
+                present[i] = false;
+            }
+            for (size_t i = 3; i < boxes.size(); i += 7) {
+                current[i] = boxes[i].translated(Vec3d(static_cast<double>(i % 5) * 100.0, 0.0, -50.0));
+                tree.updateObject(current[i], i);
+            }
+
+            ASSERT_LT(tree.depth(), 40u);
+
+            for (size_t i = 0; i < 50; ++i) {
+                const double angle = static_cast<double>(i) * 0.37;
+                const Ray3d ray(Vec3d(-8192.0, std::cos(angle) * 2048.0, std::sin(angle) * 2048.0),
+                                Vec3d(1.0, std::sin(angle) * 0.3, std::cos(angle) * 0.2).normalized());
+                ASSERT_EQ(bruteForce(current, present, ray), sorted(tree.findObjects(ray)));
+            }
+
+            const Vec3d point = current[3].center();
+            const std::vector<size_t> contained = sorted(tree.findObjects(point));
+            ASSERT_TRUE(std::binary_search(std::begin(contained), std::end(contained), 3u));
+            for (const size_t i : contained)
+                ASSERT_TRUE(current[i].contains(point));
+        }
+
+        TEST(AABBTreeTest, findIntersectingObjects) {
+            const std::vector<BBox3d> boxes = makeBoxes(1000);
+            Tree tree;
+            for (size_t i = 0; i < boxes.size(); ++i)
+                tree.addObject(boxes[i], i);
+
+            for (size_t i = 0; i < boxes.size(); i += 50) {
+                const BBox3d query = boxes[i].expanded(64.0);
+                std::vector<size_t> expected;
+                for (size_t j = 0; j < boxes.size(); ++j) {
+                    if (query.intersects(boxes[j]))
+                        expected.push_back(j);
+                }
+                ASSERT_EQ(expected, sorted(tree.findIntersectingObjects(query)));
+            }
+
+            // touching bounds intersect
+            const BBox3d touching(boxes[0].max, boxes[0].max + Vec3d(1.0, 1.0, 1.0));
+            const std::vector<size_t> result = sorted(tree.findIntersectingObjects(touching));
+            ASSERT_TRUE(std::binary_search(std::begin(result), std::end(result), 0u));
+        }
+
+        TEST(AABBTreeTest, findObjectsStopsBehindNearestHit) {
+            Tree tree;
+            for (size_t i = 0; i < 100; ++i) {
+                const double x = static_cast<double>(i) * 10.0;
+                tree.addObject(BBox3d(Vec3d(x, -1.0, -1.0), Vec3d(x + 1.0, 1.0, 1.0)), i);
+            }
+
+            const Ray3d ray(Vec3d(-10.0, 0.0, 0.0), Vec3d::PosX);
+            ASSERT_EQ(100u, tree.findObjects(ray).size());
+
+            // stop at the first hit; only objects whose bounds start before it may be visited
+            std::vector<size_t> visited;
+            tree.findObjects(ray, [&visited](const size_t object) {
+                visited.push_back(object);
+                return static_cast<double>(object) * 10.0 + 10.0;
+            });
+
+            ASSERT_FALSE(visited.empty());
+            ASSERT_EQ(0u, visited.front());
+            ASSERT_LE(visited.size(), 2u);
+        }
+
+        TEST(AABBTreeTest, findObjectsFromInsideOfBox) {
+            Tree tree;
+            tree.addObject(BBox3d(-100.0, 100.0), 1);
+            tree.addObject(BBox3d(Vec3d(10.0, -1.0, -1.0), Vec3d(11.0, 1.0, 1.0)), 2);
+
+            std::vector<size_t> visited;
+            tree.findObjects(Ray3d(Vec3d::Null, Vec3d::PosX), [&visited](const size_t object) {
+                visited.push_back(object);
+                return 50.0;
+            });
+            ASSERT_EQ(std::vector<size_t>({ 1, 2 }), sorted(visited));
+        }
+
+        TEST(AABBTreeTest, rebuild) {
+            const std::vector<BBox3d> boxes = makeBoxes(500);
+            Tree tree;
+            for (size_t i = 0; i < boxes.size(); ++i)
+                tree.addObject(boxes[i], i);
+
+            const Ray3d ray(Vec3d(-8192.0, 100.0, -200.0), Vec3d(1.0, 0.1, 0.05).normalized());
+            const std::vector<size_t> expected = sorted(tree.findObjects(ray));
+
+            tree.rebuild();
+            ASSERT_EQ(boxes.size(), tree.size());
+            ASSERT_EQ(expected, sorted(tree.findObjects(ray)));
+        }
+    }
+}
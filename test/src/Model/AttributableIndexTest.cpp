@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "Model/AttributableNode.h"
 #include "Model/AttributableNodeIndex.h"
 #include "Model/Entity.h"
@@ -161,6 +162,36 @@ namespace TrenchBroom {
         }
         
         
+        TEST(EntityAttributeIndexTest, valueOfSeveralAttributes) {
+            AttributableNodeIndex index;
+            
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("target", "door");
+            entity1->addOrUpdateAttribute("killtarget", "door");
+            
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("targetname", "door");
+            
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+            
+            ASSERT_EQ(AttributableNodeList(1, entity2), findExactExact(index, "targetname", "door"));
+            ASSERT_EQ(2u, index.findAttributableNodes(AttributableNodeIndexQuery::prefix("target"), "door").size());
+            ASSERT_EQ(2u, index.findAttributableNodes(AttributableNodeIndexQuery::any(), "door").size());
+            
+            // the node is still found through its other attribute with the same value
+            entity1->removeAttribute("killtarget");
+            index.removeAttribute(entity1, "killtarget", "door");
+            ASSERT_EQ(AttributableNodeList(1, entity1), findExactExact(index, "target", "door"));
+            
+            index.removeAttribute(entity1, "target", "door");
+            ASSERT_THROW(index.removeAttribute(entity1, "target", "door"), Exception);
+            ASSERT_TRUE(findExactExact(index, "target", "door").empty());
+            
+            delete entity1;
+            delete entity2;
+        }
+        
         TEST(EntityAttributeIndexTest, addRemoveFloatProperty) {
             AttributableNodeIndex index;
             
@@ -62,6 +62,23 @@ namespace TrenchBroom {
             ASSERT_THROW(new BrushFace(p0, p1, p2, attribs, new ParaxialTexCoordSystem(p0, p1, p2, attribs)), GeometryException);
         }
         
+        TEST(BrushFaceTest, facesShareTextureNames) {
+            BrushFaceAttributes attribs1("base_wall");
+            const BrushFaceAttributes attribs2(String("base_") + "wall");
+            ASSERT_EQ(&attribs1.textureName(), &attribs2.textureName());
+            
+            const BrushFaceAttributes snapshot = attribs1.takeSnapshot();
+            ASSERT_EQ(&attribs1.textureName(), &snapshot.textureName());
+            
+            Assets::Texture texture("other", 64, 64);
+            attribs1.setTexture(&texture);
+            ASSERT_EQ("other", attribs1.textureName());
+            ASSERT_NE(&attribs2.textureName(), &attribs1.textureName());
+            
+            attribs1.unsetTexture();
+            ASSERT_EQ(BrushFace::NoTextureName, attribs1.textureName());
+        }
+        
         TEST(BrushFaceTest, textureUsageCount) {
             const Vec3 p0(0.0,  0.0, 4.0);
             const Vec3 p1(1.f,  0.0, 4.0);
@@ -744,6 +744,96 @@ namespace TrenchBroom {
             delete clone;
         }
         
+        TEST(BrushTest, transformBrushes) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            BrushList brushes;
+            BrushList expected;
+            for (size_t i = 0; i < 64; ++i) {
+                brushes.push_back(builder.createCube(32.0, "texture"));
+                expected.push_back(builder.createCube(32.0, "texture"));
+            }
+            
+            const Mat4x4 translation = translationMatrix(Vec3(16.0, -32.0, 8.0));
+            const Mat4x4 rotation = rotationMatrix(Vec3::PosZ, Math::radians(30.0));
+            
+            Brush::transformBrushes(brushes, translation, false, worldBounds);
+            for (Brush* brush : expected)
+                brush->transform(translation, false, worldBounds);
+            
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                ASSERT_EQ(BBox3(Vec3(0.0, -48.0, -8.0), Vec3(32.0, -16.0, 24.0)), brushes[i]->bounds());
+                ASSERT_EQ(expected[i]->vertexCount(), brushes[i]->vertexCount());
+                for (const BrushVertex* vertex : expected[i]->vertices())
+                    ASSERT_TRUE(brushes[i]->hasVertex(vertex->position()));
+                
+                // the translated geometry must be identical to the geometry rebuilt from the faces
+                Brush* rebuilt = brushes[i]->clone(worldBounds);
+                ASSERT_EQ(rebuilt->bounds(), brushes[i]->bounds());
+                for (const BrushVertex* vertex : rebuilt->vertices())
+                    ASSERT_TRUE(brushes[i]->hasVertex(vertex->position()));
+                delete rebuilt;
+            }
+            
+            Brush::transformBrushes(brushes, rotation, false, worldBounds);
+            for (Brush* brush : expected)
+                brush->transform(rotation, false, worldBounds);
+            
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                ASSERT_EQ(expected[i]->bounds(), brushes[i]->bounds());
+                ASSERT_EQ(expected[i]->vertexCount(), brushes[i]->vertexCount());
+                for (const BrushVertex* vertex : expected[i]->vertices())
+                    ASSERT_TRUE(brushes[i]->hasVertex(vertex->position()));
+            }
+            
+            VectorUtils::clearAndDelete(brushes);
+            VectorUtils::clearAndDelete(expected);
+        }
+        
+        TEST(BrushTest, findIntegerPlanePointsOfBrushes) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            const Mat4x4 rotation = rotationMatrix(Vec3(1.0, 2.0, 3.0).normalized(), Math::radians(17.0));
+            
+            BrushList brushes;
+            BrushList expected;
+            for (size_t i = 0; i < 32; ++i) {
+                const Mat4x4 transformation = translationMatrix(Vec3(static_cast<FloatType>(i) * 64.0, 0.0, 0.0)) * rotation;
+                brushes.push_back(builder.createCube(32.0, "texture"));
+                brushes.back()->transform(transformation, false, worldBounds);
+                expected.push_back(builder.createCube(32.0, "texture"));
+                expected.back()->transform(transformation, false, worldBounds);
+            }
+            
+            std::vector<double> progress;
+            Brush::findIntegerPlanePoints(brushes, worldBounds, [&](const double p) { progress.push_back(p); });
+            for (Brush* brush : expected)
+                brush->findIntegerPlanePoints(worldBounds);
+            
+            ASSERT_FALSE(progress.empty());
+            ASSERT_TRUE(std::is_sorted(std::begin(progress), std::end(progress)));
+            ASSERT_DOUBLE_EQ(1.0, progress.back());
+            
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                ASSERT_EQ(expected[i]->faceCount(), brushes[i]->faceCount());
+                for (size_t j = 0; j < brushes[i]->faceCount(); ++j) {
+                    const BrushFace* face = brushes[i]->faces()[j];
+                    for (size_t k = 0; k < 3; ++k) {
+                        ASSERT_EQ(face->points()[k].rounded(), face->points()[k]);
+                        ASSERT_EQ(expected[i]->faces()[j]->points()[k], face->points()[k]);
+                    }
+                }
+                ASSERT_EQ(expected[i]->bounds(), brushes[i]->bounds());
+            }
+            
+            VectorUtils::clearAndDelete(brushes);
+            VectorUtils::clearAndDelete(expected);
+        }
+        
         TEST(BrushTest, clip) {
             const BBox3 worldBounds(4096.0);
             
@@ -3353,6 +3443,86 @@ namespace TrenchBroom {
             delete cube;
         }
 
+        TEST(BrushTest, snapshotRestoresGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            Brush* cube = builder.createCube(64.0, "texture");
+            const BBox3 originalBounds = cube->bounds();
+            const Vec3 vertex(32.0, 32.0, 32.0);
+            
+            NodeSnapshot* translateSnapshot = cube->takeSnapshot();
+            cube->transform(translationMatrix(Vec3(16.0, 0.0, 0.0)), false, worldBounds);
+            ASSERT_EQ(originalBounds.translated(Vec3(16.0, 0.0, 0.0)), cube->bounds());
+            
+            NodeSnapshot* moveSnapshot = cube->takeSnapshot();
+            ASSERT_TRUE(cube->canMoveVertices(worldBounds, Vec3::List(1, Vec3(48.0, 32.0, 32.0)), Vec3(16.0, 0.0, 0.0)));
+            cube->moveVertices(worldBounds, Vec3::List(1, Vec3(48.0, 32.0, 32.0)), Vec3(16.0, 0.0, 0.0));
+            ASSERT_EQ(8u, cube->vertexCount());
+            ASSERT_TRUE(cube->hasVertex(Vec3(64.0, 32.0, 32.0)));
+            
+            moveSnapshot->restore(worldBounds);
+            ASSERT_EQ(originalBounds.translated(Vec3(16.0, 0.0, 0.0)), cube->bounds());
+            ASSERT_TRUE(cube->hasVertex(Vec3(48.0, 32.0, 32.0)));
+            
+            translateSnapshot->restore(worldBounds);
+            ASSERT_EQ(originalBounds, cube->bounds());
+            ASSERT_EQ(8u, cube->vertexCount());
+            ASSERT_EQ(6u, cube->faceCount());
+            ASSERT_TRUE(cube->hasVertex(vertex));
+            ASSERT_TRUE(cube->fullySpecified());
+            
+            // the faces must be linked to the restored geometry
+            for (const BrushFace* face : cube->faces()) {
+                ASSERT_TRUE(face->geometry() != nullptr);
+                ASSERT_EQ(4u, face->vertexCount());
+                const Polygon3 polygon = face->polygon();
+                for (const Vec3& position : polygon.vertices())
+                    ASSERT_EQ(Math::PointStatus::PSInside, face->boundary().pointStatus(position));
+            }
+            
+            // the restored geometry must be modifiable without affecting other brushes
+            Brush* clone = cube->clone(worldBounds);
+            cube->transform(translationMatrix(Vec3(0.0, 32.0, 0.0)), false, worldBounds);
+            ASSERT_EQ(originalBounds, clone->bounds());
+            ASSERT_EQ(originalBounds.translated(Vec3(0.0, 32.0, 0.0)), cube->bounds());
+            
+            delete clone;
+            delete moveSnapshot;
+            delete translateSnapshot;
+            delete cube;
+        }
+        
+        TEST(BrushTest, cloneCopiesGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            
+            Brush* brush = builder.createCube(64.0, "texture");
+            brush->moveVertices(worldBounds, Vec3::List(1, Vec3(32.0, 32.0, 32.0)), Vec3(-16.0, -16.0, -16.0));
+            
+            Brush* clone = brush->clone(worldBounds);
+            ASSERT_EQ(brush->bounds(), clone->bounds());
+            ASSERT_EQ(brush->vertexCount(), clone->vertexCount());
+            ASSERT_EQ(brush->edgeCount(), clone->edgeCount());
+            ASSERT_EQ(brush->faceCount(), clone->faceCount());
+            for (const BrushVertex* vertex : brush->vertices())
+                ASSERT_TRUE(clone->hasVertex(vertex->position()));
+            
+            for (size_t i = 0; i < brush->faceCount(); ++i) {
+                const BrushFace* original = brush->faces()[i];
+                const BrushFace* face = clone->faces()[i];
+                ASSERT_EQ(clone, face->brush());
+                ASSERT_TRUE(face->geometry() != nullptr);
+                ASSERT_EQ(original->boundary(), face->boundary());
+                ASSERT_EQ(original->polygon(), face->polygon());
+            }
+            
+            delete clone;
+            delete brush;
+        }
+
         TEST(BrushTest, resizePastWorldBounds) {
             const BBox3 worldBounds(8192.0);
             World world(MapFormat::Standard, nullptr, worldBounds);
@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/EntityAttributes.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(EntityAttributesTest, attributesShareNames) {
+            const EntityAttribute attribute1("target", "door1");
+            const EntityAttribute attribute2(String("tar") + "get", "door2");
+            ASSERT_EQ(&attribute1.name(), &attribute2.name());
+            ASSERT_TRUE(attribute1 < attribute2);
+            
+            EntityAttribute attribute3("targetname", "door1");
+            ASSERT_TRUE(attribute1 < attribute3);
+            attribute3.setName("target", NULL);
+            ASSERT_EQ(&attribute1.name(), &attribute3.name());
+            ASSERT_EQ(0, attribute1.compare(attribute3));
+        }
+        
+        TEST(EntityAttributesTest, addOrUpdateAttribute) {
+            EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("target", "door1", NULL);
+            attributes.addOrUpdateAttribute("target", "door2", NULL);
+            
+            ASSERT_EQ(1u, attributes.attributes().size());
+            ASSERT_TRUE(attributes.hasAttribute("target", "door2"));
+            ASSERT_TRUE(attributes.hasNumberedAttribute("target", "door2"));
+            ASSERT_FALSE(attributes.hasAttribute("target", "door1"));
+        }
+    }
+}
@@ -0,0 +1,250 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "VecMath.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/CollectContainedNodesVisitor.h"
+#include "Model/CollectTouchingNodesVisitor.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodePredicates.h"
+#include "Model/ModelUtils.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static NodeList sorted(NodeList nodes) {
+            VectorUtils::sortAndRemoveDuplicates(nodes);
+            return nodes;
+        }
+
+        TEST(ModelUtilsTest, collectNodesIntersecting) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            const EditorContext editorContext;
+
+            // a row of cubes that touch their neighbours, the last four of which are grouped
+            BrushList brushes;
+            Group* group = new Group("group");
+            world.defaultLayer()->addChild(group);
+            for (size_t i = 0; i < 20; ++i) {
+                Brush* brush = builder.createCube(16.0, "texture");
+                brush->transform(translationMatrix(Vec3(static_cast<FloatType>(i) * 16.0, 0.0, 0.0)), false, worldBounds);
+                if (i < 16)
+                    world.defaultLayer()->addChild(brush);
+                else
+                    group->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            Layer* layer = new Layer("layer", worldBounds);
+            world.addChild(layer);
+            Brush* inside = builder.createCube(4.0, "texture");
+            inside->transform(translationMatrix(Vec3(80.0, 0.0, 0.0)), false, worldBounds);
+            layer->addChild(inside);
+
+            Brush* selection = builder.createCube(48.0, "texture");
+            selection->transform(translationMatrix(Vec3(80.0, 0.0, 0.0)), false, worldBounds);
+            const BrushList selected(1, selection);
+
+            NodeList expected;
+            expected.push_back(brushes[3]);
+            expected.push_back(brushes[4]);
+            expected.push_back(brushes[5]);
+            expected.push_back(brushes[6]);
+            expected.push_back(brushes[7]);
+            expected.push_back(inside);
+            ASSERT_EQ(sorted(expected), sorted(collectNodesIntersecting(&world, selected)));
+
+            // the broad phase must not change the result of the touching and contained queries
+            const NodeList candidates = collectNodesIntersecting(&world, selected);
+
+            CollectTouchingNodesVisitor<BrushList::const_iterator> allTouching(std::begin(selected), std::end(selected), editorContext);
+            world.acceptAndRecurse(allTouching);
+            CollectTouchingNodesVisitor<BrushList::const_iterator> touching(std::begin(selected), std::end(selected), editorContext);
+            Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), touching);
+            ASSERT_EQ(sorted(allTouching.nodes()), sorted(touching.nodes()));
+
+            CollectContainedNodesVisitor<BrushList::const_iterator> allContained(std::begin(selected), std::end(selected), editorContext);
+            world.acceptAndRecurse(allContained);
+            CollectContainedNodesVisitor<BrushList::const_iterator> contained(std::begin(selected), std::end(selected), editorContext);
+            Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), contained);
+            ASSERT_EQ(sorted(allContained.nodes()), sorted(contained.nodes()));
+            ASSERT_FALSE(contained.nodes().empty());
+
+            // overlapping brushes yield every candidate once, in the order in which it was first found
+            Brush* overlapping = builder.createCube(48.0, "texture");
+            overlapping->transform(translationMatrix(Vec3(96.0, 0.0, 0.0)), false, worldBounds);
+            const BrushList both({ selection, overlapping });
+            
+            NodeList found;
+            for (const Layer* each : world.allLayers()) {
+                for (const Brush* brush : both)
+                    each->findNodesIntersecting(brush->bounds(), found);
+            }
+            
+            NodeList firstFound;
+            for (Node* node : found) {
+                if (!VectorUtils::contains(firstFound, node))
+                    firstFound.push_back(node);
+            }
+            ASSERT_LT(firstFound.size(), found.size());
+            ASSERT_EQ(firstFound, collectNodesIntersecting(&world, both));
+            delete overlapping;
+            
+            // the group is a candidate once one of its brushes is in range
+            selection->transform(translationMatrix(Vec3(176.0, 0.0, 0.0)), false, worldBounds);
+            const NodeList groupCandidates = collectNodesIntersecting(&world, selected);
+            ASSERT_TRUE(VectorUtils::contains(groupCandidates, group));
+
+            delete selection;
+        }
+
+        TEST(ModelUtilsTest, estimateMemoryUsage) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+
+            Brush* brush1 = builder.createCube(16.0, "texture");
+            Brush* brush2 = builder.createCube(16.0, "texture");
+            const size_t brushMemory = estimateMemoryUsage(NodeList(1, brush1));
+            ASSERT_LT(sizeof(Brush) + 6 * sizeof(BrushFace), brushMemory);
+
+            Entity* entity = world.createEntity();
+            entity->addOrUpdateAttribute(AttributeNames::Classname, "func_wall");
+            entity->addChild(brush1);
+            entity->addChild(brush2);
+
+            const NodeList nodes(1, entity);
+            const size_t entityMemory = estimateMemoryUsage(nodes);
+            ASSERT_LT(sizeof(Entity) + 2 * brushMemory, entityMemory);
+
+            ParentChildrenMap map;
+            map[world.defaultLayer()] = nodes;
+            ASSERT_EQ(estimateReferenceMemoryUsage(map) + entityMemory, estimateMemoryUsage(map));
+
+            delete entity;
+        }
+
+        class FarBrushIssueGenerator : public IssueGenerator {
+        private:
+            class FarBrushIssue : public Issue {
+            public:
+                FarBrushIssue(Brush* brush) :
+                Issue(brush) {}
+            private:
+                IssueType doGetType() const { return 1; }
+                const String doGetDescription() const { return "Brush is far away"; }
+            };
+        public:
+            FarBrushIssueGenerator() :
+            IssueGenerator(1, "Far brush") {}
+        private:
+            void doGenerate(Brush* brush, IssueList& issues) const {
+                if (brush->bounds().min.x() > 1024.0)
+                    issues.push_back(new FarBrushIssue(brush));
+            }
+        };
+
+        TEST(ModelUtilsTest, validateIssues) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new FarBrushIssueGenerator());
+            const BrushBuilder builder(&world, worldBounds);
+
+            // every third brush is far away
+            BrushList brushes;
+            for (size_t i = 0; i < 300; ++i) {
+                Brush* brush = builder.createCube(16.0, "texture");
+                const FloatType offset = i % 3 == 0 ? 2048.0 : 0.0;
+                brush->transform(translationMatrix(Vec3(offset, static_cast<FloatType>(i), 0.0)), false, worldBounds);
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            validateIssues(&world, world.registeredIssueGenerators());
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                Brush* brush = brushes[i];
+                ASSERT_TRUE(brush->issuesValid());
+
+                const IssueList& issues = brush->issues(world.registeredIssueGenerators());
+                if (i % 3 == 0) {
+                    ASSERT_EQ(1u, issues.size());
+                    ASSERT_EQ(brush, issues.front()->node());
+                } else {
+                    ASSERT_TRUE(issues.empty());
+                }
+            }
+
+            // only invalidated nodes are validated again
+            const Issue* issue = brushes[0]->issues(world.registeredIssueGenerators()).front();
+            brushes[1]->transform(translationMatrix(Vec3(2048.0, 0.0, 0.0)), false, worldBounds);
+            ASSERT_FALSE(brushes[1]->issuesValid());
+
+            validateIssues(&world, world.registeredIssueGenerators());
+            ASSERT_EQ(issue, brushes[0]->issues(world.registeredIssueGenerators()).front());
+            ASSERT_EQ(1u, brushes[1]->issues(world.registeredIssueGenerators()).size());
+        }
+
+        TEST(ModelUtilsTest, collectLinkedNodes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+
+            // a chain 1 -> 2 -> 3, where 3 is also killed by 4, and an unrelated entity 5
+            Entity* entities[5];
+            for (size_t i = 0; i < 5; ++i) {
+                entities[i] = world.createEntity();
+                world.defaultLayer()->addChild(entities[i]);
+            }
+            entities[0]->addOrUpdateAttribute(AttributeNames::Target, "second");
+            entities[1]->addOrUpdateAttribute(AttributeNames::Targetname, "second");
+            entities[1]->addOrUpdateAttribute(AttributeNames::Target, "third");
+            entities[2]->addOrUpdateAttribute(AttributeNames::Targetname, "third");
+            entities[3]->addOrUpdateAttribute(AttributeNames::Killtarget, "third");
+            entities[4]->addOrUpdateAttribute(AttributeNames::Targetname, "other");
+
+            AttributableNodeList expected;
+            expected.push_back(entities[0]);
+            expected.push_back(entities[1]);
+            expected.push_back(entities[2]);
+            expected.push_back(entities[3]);
+            VectorUtils::sort(expected);
+
+            AttributableNodeList linked = collectLinkedNodes(AttributableNodeList(1, entities[2]), NodePredicates::True());
+            VectorUtils::sort(linked);
+            ASSERT_EQ(expected, linked);
+
+            // the links of excluded nodes are not followed
+            const Entity* excluded = entities[1];
+            linked = collectLinkedNodes(AttributableNodeList(1, entities[0]), [excluded](const AttributableNode* node) { return node != excluded; });
+            ASSERT_EQ(AttributableNodeList(1, entities[0]), linked);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/NodeCollection.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(NodeCollectionTest, addAndRemoveNodes) {
+            Entity entity1, entity2, entity3;
+            Group group("group");
+
+            NodeCollection collection;
+            collection.addNodes(NodeList({ &entity1, &group, &entity2, &entity3 }));
+            ASSERT_EQ(4u, collection.nodeCount());
+            ASSERT_EQ(3u, collection.entityCount());
+            ASSERT_EQ(1u, collection.groupCount());
+            ASSERT_TRUE(collection.contains(&entity2));
+
+            // nodes are only added once
+            collection.addNode(&entity2);
+            ASSERT_EQ(4u, collection.nodeCount());
+
+            // removal keeps the order of the remaining nodes and ignores unknown nodes
+            Entity unknown;
+            collection.removeNodes(NodeList({ &entity2, &group, &unknown }));
+            ASSERT_FALSE(collection.contains(&entity2));
+            ASSERT_FALSE(collection.hasGroups());
+            ASSERT_TRUE(collection.hasOnlyEntities());
+            ASSERT_EQ(NodeList({ &entity1, &entity3 }), collection.nodes());
+            ASSERT_EQ(EntityList({ &entity1, &entity3 }), collection.entities());
+
+            collection.removeNode(&entity1);
+            ASSERT_EQ(NodeList(1, &entity3), collection.nodes());
+
+            collection.clear();
+            ASSERT_TRUE(collection.empty());
+            ASSERT_FALSE(collection.contains(&entity3));
+        }
+    }
+}
@@ -21,10 +21,15 @@
 
 #include "Exceptions.h"
 #include "VecMath.h"
+#include "Model/AABBTree.h"
 #include "Model/Octree.h"
 #include "Model/Object.h"
 #include "Model/Brush.h"
 
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
 namespace TrenchBroom {
     namespace Model {
         TEST(OctreeTest, insertObject) {
@@ -73,5 +78,97 @@ namespace TrenchBroom {
             octree.addObject(aBounds, a);
             ASSERT_THROW(octree.removeObject(b), OctreeException);
         }
+        
+        /*
+         Compares picking in an octree with picking in an AABB tree. The benchmark is disabled by default; run it with
+         --gtest_also_run_disabled_tests --gtest_filter=OctreeBenchmark.*
+         */
+        
+        template <typename F>
+        double measurePicking(const size_t repetitions, F f) {
+            typedef std::chrono::high_resolution_clock Clock;
+            const Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < repetitions; ++i)
+                f(i);
+            const Clock::time_point end = Clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        
+        TEST(OctreeBenchmark, DISABLED_picking) {
+            const BBox3d worldBounds(-8192.0, 8192.0);
+            const size_t count = 100000;
+            const size_t rays = 1000;
+            
+            // a dense map with many small brushes and some large ones
+            std::vector<BBox3d> boxes;
+            unsigned int seed = 1;
+            const auto next = [&seed]() {
+                seed = seed * 1103515245u + 12345u;
+                return static_cast<double>((seed >> 8) % 12288) - 6144.0;
+            };
+            for (size_t i = 0; i < count; ++i) {
+                const Vec3d center(next(), next(), next() / 8.0);
+                const double size = i % 50 == 0 ? 1024.0 : 32.0;
+                boxes.push_back(BBox3d(center - Vec3d(size, size, size), center + Vec3d(size, size, size)));
+            }
+            
+            std::vector<Ray3d> pickRays;
+            for (size_t i = 0; i < rays; ++i) {
+                const double angle = static_cast<double>(i) * 0.1;
+                pickRays.push_back(Ray3d(Vec3d(std::cos(angle) * 4096.0, std::sin(angle) * 4096.0, 512.0),
+                                         Vec3d(-std::cos(angle), -std::sin(angle), -0.1).normalized()));
+            }
+            
+            Octree<double, size_t> octree(worldBounds, 64.0);
+            AABBTree<double, size_t> tree;
+            
+            std::cout << "build: octree " << measurePicking(1, [&](size_t) {
+                for (size_t i = 0; i < count; ++i)
+                    octree.addObject(boxes[i], i);
+            }) << "ms, aabb tree " << measurePicking(1, [&](size_t) {
+                for (size_t i = 0; i < count; ++i)
+                    tree.addObject(boxes[i], i);
+            }) << "ms" << std::endl;
+            
+            // test the candidates against their bounds, which stands in for picking the actual objects
+            size_t octreeHits = 0;
+            const double octreeMs = measurePicking(rays, [&](const size_t i) {
+                double nearest = std::numeric_limits<double>::infinity();
+                for (const size_t object : octree.findObjects(pickRays[i])) {
+                    const double distance = boxes[object].intersectWithRay(pickRays[i]);
+                    if (!Math::isnan(distance))
+                        nearest = std::min(nearest, distance);
+                }
+                octreeHits += nearest < std::numeric_limits<double>::infinity() ? 1 : 0;
+            });
+            
+            size_t treeHits = 0;
+            const double treeMs = measurePicking(rays, [&](const size_t i) {
+                double nearest = std::numeric_limits<double>::infinity();
+                tree.findObjects(pickRays[i], [&](const size_t object) {
+                    const double distance = boxes[object].intersectWithRay(pickRays[i]);
+                    if (!Math::isnan(distance))
+                        nearest = std::min(nearest, distance);
+                    return std::numeric_limits<double>::infinity();
+                });
+                treeHits += nearest < std::numeric_limits<double>::infinity() ? 1 : 0;
+            });
+            
+            size_t nearestHits = 0;
+            const double nearestMs = measurePicking(rays, [&](const size_t i) {
+                double nearest = std::numeric_limits<double>::infinity();
+                tree.findObjects(pickRays[i], [&](const size_t object) {
+                    const double distance = boxes[object].intersectWithRay(pickRays[i]);
+                    if (!Math::isnan(distance))
+                        nearest = std::min(nearest, distance);
+                    return nearest;
+                });
+                nearestHits += nearest < std::numeric_limits<double>::infinity() ? 1 : 0;
+            });
+            
+            std::cout << "pick " << rays << " rays: octree " << octreeMs << "ms, aabb tree " << treeMs << "ms, aabb tree nearest only " << nearestMs << "ms" << std::endl;
+            ASSERT_EQ(octreeHits, treeHits);
+            ASSERT_EQ(octreeHits, nearestHits);
+        }
     }
 }
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "VecMath.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/CollectMatchingBrushFacesVisitor.h"
+#include "Model/CollectMatchingNodesVisitor.h"
+#include "Model/ComputeNodeBoundsVisitor.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/NodePredicates.h"
+#include "Model/ParallelNodeTraversal.h"
+#include "Model/World.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Model {
+        class ParallelNodeTraversalTest : public ::testing::Test {
+        protected:
+            BBox3 worldBounds;
+            World world;
+        protected:
+            ParallelNodeTraversalTest() :
+            worldBounds(8192.0),
+            world(MapFormat::Standard, NULL, worldBounds) {}
+
+            void SetUp() {
+                const BrushBuilder builder(&world, worldBounds);
+                Layer* layer = world.defaultLayer();
+
+                Entity* entity = world.createEntity();
+                Group* group = world.createGroup("group");
+                layer->addChild(entity);
+                layer->addChild(group);
+                layer->addChild(world.createEntity());
+
+                for (size_t i = 0; i < 300; ++i) {
+                    const Vec3 min(static_cast<FloatType>(i) * 16.0 - 2400.0, 0.0, 0.0);
+                    Brush* brush = builder.createCuboid(BBox3(min, min + Vec3(8.0, 8.0, 8.0)), "texture");
+                    if (i % 3 == 0)
+                        layer->addChild(brush);
+                    else if (i % 3 == 1)
+                        entity->addChild(brush);
+                    else
+                        group->addChild(brush);
+                }
+            }
+        };
+
+        class MatchGroups {
+        public:
+            bool operator()(const Node* node) const   { return false; }
+            bool operator()(const Group* group) const { return true;  }
+        };
+
+        static NodeList sorted(NodeList nodes) {
+            std::sort(std::begin(nodes), std::end(nodes));
+            return nodes;
+        }
+
+        TEST_F(ParallelNodeTraversalTest, collectNodes) {
+            typedef CollectMatchingNodesVisitor<NodePredicates::True> CollectAllNodes;
+
+            CollectAllNodes sequential;
+            world.acceptAndRecurse(sequential);
+
+            CollectAllNodes parallel;
+            parallelAcceptAndRecurse(&world, parallel, 1);
+            ASSERT_EQ(sorted(sequential.nodes()), sorted(parallel.nodes()));
+
+            // the nodes with children are visited first, then the others in traversal order
+            const Layer* layer = world.defaultLayer();
+            ASSERT_EQ(&world, parallel.nodes()[0]);
+            ASSERT_EQ(layer, parallel.nodes()[1]);
+            ASSERT_EQ(layer->children()[0], parallel.nodes()[2]);
+            ASSERT_EQ(layer->children()[1], parallel.nodes()[3]);
+
+            CollectAllNodes again;
+            parallelAcceptAndRecurse(&world, again, 1);
+            ASSERT_EQ(parallel.nodes(), again.nodes());
+        }
+
+        TEST_F(ParallelNodeTraversalTest, stopRecursion) {
+            typedef CollectMatchingNodesVisitor<MatchGroups, StandardNodeCollectionStrategy, StopRecursionIfMatched> CollectGroups;
+
+            CollectGroups visitor;
+            parallelAcceptAndRecurse(&world, visitor, 1);
+            ASSERT_EQ(1u, visitor.nodes().size());
+            ASSERT_EQ(world.defaultLayer()->children()[1], visitor.nodes().front());
+        }
+
+        TEST_F(ParallelNodeTraversalTest, collectBrushFaces) {
+            CollectBrushFacesVisitor sequential;
+            world.acceptAndRecurse(sequential);
+
+            CollectBrushFacesVisitor parallel;
+            parallelAcceptAndRecurse(&world, parallel, 1);
+            ASSERT_EQ(300u * 6u, parallel.faces().size());
+            ASSERT_EQ(sequential.faces(), parallel.faces());
+        }
+
+        TEST_F(ParallelNodeTraversalTest, computeBounds) {
+            ComputeNodeBoundsVisitor sequential;
+            world.acceptAndRecurse(sequential);
+
+            ComputeNodeBoundsVisitor parallel;
+            parallelAcceptAndRecurse(static_cast<const World*>(&world), parallel, 1);
+            ASSERT_EQ(sequential.bounds(), parallel.bounds());
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "VecMath.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Model/World.h"
+
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(PickResultTest, nearestKeepsNearestMatchingHits) {
+            const EditorContext editorContext;
+            PickResult pickResult = PickResult::nearest(editorContext, new TypedHitFilter(Brush::BrushHit));
+            ASSERT_EQ(std::numeric_limits<FloatType>::infinity(), pickResult.maxDistance());
+
+            BrushFace* face = NULL;
+            pickResult.addHit(Hit(Brush::BrushHit, 10.0, Vec3::Null, face));
+            ASSERT_EQ(10.0, pickResult.maxDistance());
+
+            // other hit types and hits behind the nearest hit are dropped
+            pickResult.addHit(Hit(Entity::EntityHit, 5.0, Vec3::Null, face));
+            pickResult.addHit(Hit(Brush::BrushHit, 12.0, Vec3::Null, face));
+            ASSERT_EQ(1u, pickResult.size());
+
+            pickResult.addHit(Hit(Brush::BrushHit, 10.0, Vec3::Null, face));
+            ASSERT_EQ(2u, pickResult.size());
+
+            pickResult.addHit(Hit(Brush::BrushHit, 4.0, Vec3::Null, face));
+            ASSERT_EQ(1u, pickResult.size());
+            ASSERT_EQ(4.0, pickResult.maxDistance());
+            ASSERT_EQ(4.0, pickResult.all().front().distance());
+        }
+
+        TEST(PickResultTest, byDistanceKeepsAllHits) {
+            const EditorContext editorContext;
+            PickResult pickResult = PickResult::byDistance(editorContext);
+
+            BrushFace* face = NULL;
+            pickResult.addHit(Hit(Brush::BrushHit, 10.0, Vec3::Null, face));
+            pickResult.addHit(Hit(Brush::BrushHit, 4.0, Vec3::Null, face));
+            ASSERT_EQ(2u, pickResult.size());
+            ASSERT_EQ(std::numeric_limits<FloatType>::infinity(), pickResult.maxDistance());
+        }
+
+        TEST(PickResultTest, pickNearestBrushInLayer) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+
+            BrushList brushes;
+            for (size_t i = 0; i < 100; ++i) {
+                Brush* brush = builder.createCube(16.0, "texture");
+                brush->transform(translationMatrix(Vec3(static_cast<FloatType>(i) * 32.0, 0.0, 0.0)), false, worldBounds);
+                world.defaultLayer()->addChild(brush);
+                brushes.push_back(brush);
+            }
+
+            const Ray3 ray(Vec3(-64.0, 0.0, 0.0), Vec3::PosX);
+            const EditorContext editorContext;
+
+            PickResult all = PickResult::byDistance(editorContext);
+            world.pick(ray, all);
+            ASSERT_EQ(100u, all.size());
+
+            PickResult nearest = PickResult::nearest(editorContext, new TypedHitFilter(Brush::BrushHit));
+            world.pick(ray, nearest);
+            ASSERT_EQ(1u, nearest.size());
+            ASSERT_EQ(all.all().front().distance(), nearest.all().front().distance());
+            ASSERT_EQ(brushes.front(), hitToBrush(nearest.all().front()));
+        }
+    }
+}
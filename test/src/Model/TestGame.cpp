@@ -64,6 +64,11 @@ namespace TrenchBroom {
         }
         
         void TestGame::doWriteMap(World* world, const IO::Path& path) const {}
+        
+        void TestGame::doWriteMapToStream(World* world, std::ostream& stream) const {
+            IO::NodeWriter writer(world, stream);
+            writer.writeMap();
+        }
         void TestGame::doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const {}
         
         NodeList TestGame::doParseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const {
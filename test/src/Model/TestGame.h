@@ -46,6 +46,7 @@ namespace TrenchBroom {
             World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const;
             World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
             void doWriteMap(World* world, const IO::Path& path) const;
+            void doWriteMapToStream(World* world, std::ostream& stream) const;
             void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
             
             NodeList doParseNodes(const String& str, World* world, const BBox3& worldBounds, Logger* logger) const;
@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Notifier.h"
+#include "NotificationQueue.h"
+
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    class CountingObserver {
+    public:
+        size_t count;
+        size_t sum;
+
+        CountingObserver() : count(0), sum(0) {}
+
+        void notified(const size_t value) {
+            ++count;
+            sum += value;
+        }
+    };
+
+    TEST(NotificationQueueTest, drainDeliversInOrder) {
+        NotificationQueue queue;
+        ASSERT_FALSE(queue.hasPending());
+        ASSERT_EQ(0u, queue.drain());
+
+        std::vector<size_t> delivered;
+        for (size_t i = 0; i < 3; ++i)
+            queue.post([&delivered, i]() { delivered.push_back(i); });
+
+        ASSERT_TRUE(queue.hasPending());
+        ASSERT_TRUE(delivered.empty());
+
+        ASSERT_EQ(3u, queue.drain());
+        ASSERT_FALSE(queue.hasPending());
+        ASSERT_EQ(std::vector<size_t>({ 0, 1, 2 }), delivered);
+    }
+
+    TEST(NotificationQueueTest, postDuringDrain) {
+        NotificationQueue queue;
+        size_t count = 0;
+        queue.post([&queue, &count]() {
+            ++count;
+            queue.post([&count]() { ++count; });
+        });
+
+        ASSERT_EQ(1u, queue.drain());
+        ASSERT_EQ(1u, count);
+        ASSERT_TRUE(queue.hasPending());
+        ASSERT_EQ(1u, queue.drain());
+        ASSERT_EQ(2u, count);
+    }
+
+    TEST(NotificationQueueTest, notifyFromWorkerThreads) {
+        Notifier1<size_t> notifier;
+        CountingObserver observer;
+        notifier.addObserver(&observer, &CountingObserver::notified);
+
+        NotificationQueue queue;
+        const size_t threadCount = 4;
+        const size_t notificationsPerThread = 1000;
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.push_back(std::thread([&queue, &notifier, notificationsPerThread]() {
+                for (size_t j = 0; j < notificationsPerThread; ++j)
+                    queue.notify(notifier, j);
+            }));
+        }
+
+        // observers are only called on this thread
+        size_t delivered = 0;
+        while (delivered < threadCount * notificationsPerThread)
+            delivered += queue.drain();
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        ASSERT_EQ(threadCount * notificationsPerThread, observer.count);
+        ASSERT_EQ(threadCount * notificationsPerThread * (notificationsPerThread - 1) / 2, observer.sum);
+    }
+}
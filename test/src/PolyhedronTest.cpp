@@ -111,6 +111,22 @@ TEST(PolyhedronTest, copy) {
     ASSERT_EQ(original, copy);
 }
 
+TEST(PolyhedronTest, translate) {
+    const Vec3d p1( 0.0, 0.0, 8.0);
+    const Vec3d p2( 8.0, 0.0, 0.0);
+    const Vec3d p3(-8.0, 0.0, 0.0);
+    const Vec3d p4( 0.0, 8.0, 0.0);
+    const Vec3d delta(16.0, -8.0, 32.0);
+    
+    Polyhedron3d p(p1, p2, p3, p4);
+    p.translate(delta);
+    
+    const Polyhedron3d expected(p1 + delta, p2 + delta, p3 + delta, p4 + delta);
+    ASSERT_EQ(expected, p);
+    ASSERT_EQ(expected.bounds(), p.bounds());
+    ASSERT_TRUE(hasTriangleOf(p, p2 + delta, p3 + delta, p4 + delta));
+}
+
 TEST(PolyhedronTest, swap) {
     const Vec3d p1( 0.0, 0.0, 8.0);
     const Vec3d p2( 8.0, 0.0, 0.0);
@@ -1396,6 +1412,78 @@ TEST(PolyhedronTest, crashWhileAddingPoints5) {
     p.addPoint(p2); // Assertion failure here - re-adding p2
 }
 
+TEST(PolyhedronTest, addManyPointsOfCube) {
+    // all integer points of a cube, most of which are inside the cube or on its faces
+    Vec3d::List points;
+    for (int x = -2; x <= 2; ++x) {
+        for (int y = -2; y <= 2; ++y) {
+            for (int z = -2; z <= 2; ++z)
+                points.push_back(Vec3d(x, y, z));
+        }
+    }
+    
+    const Polyhedron3d p(points);
+    ASSERT_TRUE(p.closed());
+    ASSERT_EQ(8u, p.vertexCount());
+    ASSERT_EQ(12u, p.edgeCount());
+    ASSERT_EQ(6u, p.faceCount());
+    ASSERT_EQ(BBox3d(2.0), p.bounds());
+    
+    ASSERT_TRUE(hasQuadOf(p, Vec3d(-2.0, -2.0, -2.0), Vec3d(-2.0, -2.0, +2.0), Vec3d(-2.0, +2.0, +2.0), Vec3d(-2.0, +2.0, -2.0)));
+    ASSERT_TRUE(hasQuadOf(p, Vec3d(+2.0, -2.0, -2.0), Vec3d(+2.0, +2.0, -2.0), Vec3d(+2.0, +2.0, +2.0), Vec3d(+2.0, -2.0, +2.0)));
+}
+
+TEST(PolyhedronTest, addManyPointsMatchesIncrementalHull) {
+    // points on and inside a sphere, generated deterministically
+    Vec3d::List points;
+    unsigned int seed = 1;
+    for (size_t i = 0; i < 500; ++i) {
+        Vec3d point;
+        for (size_t j = 0; j < 3; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            point[j] = static_cast<double>((seed >> 8) % 2001) - 1000.0;
+        }
+        if (i % 2 == 0)
+            point = 1000.0 * point.normalized();
+        points.push_back(point);
+    }
+    
+    Polyhedron3d incremental;
+    for (const Vec3d& point : points)
+        incremental.addPoint(point);
+    
+    const Polyhedron3d bulk(points);
+    ASSERT_TRUE(bulk.closed());
+    ASSERT_EQ(incremental, bulk);
+    
+    for (const Vec3d& point : points)
+        ASSERT_TRUE(bulk.contains(point));
+}
+
+TEST(PolyhedronTest, mergeAddsPointsInBulk) {
+    const Polyhedron3d lhs(BBox3d(Vec3d(0.0, 0.0, 0.0), Vec3d(32.0, 32.0, 32.0)));
+    
+    // an octagonal prism
+    Vec3d::List prism;
+    for (size_t i = 0; i < 8; ++i) {
+        const double angle = Math::radians(45.0 * static_cast<double>(i));
+        prism.push_back(Vec3d(32.0 + 24.0 * std::cos(angle), 32.0 + 24.0 * std::sin(angle), 16.0));
+        prism.push_back(Vec3d(32.0 + 24.0 * std::cos(angle), 32.0 + 24.0 * std::sin(angle), 48.0));
+    }
+    const Polyhedron3d rhs(prism);
+    ASSERT_EQ(16u, rhs.vertexCount());
+    
+    Polyhedron3d merged(lhs);
+    merged.merge(rhs);
+    
+    Polyhedron3d expected(lhs);
+    for (const Vertex* vertex : rhs.vertices())
+        expected.addPoint(vertex->position());
+    
+    ASSERT_TRUE(merged.closed());
+    ASSERT_EQ(expected, merged);
+}
+
 TEST(PolyhedronTest, removeVertexFromPoint) {
     const Vec3d p1(  0.0,   0.0,   0.0);
     
@@ -2637,6 +2725,16 @@ TEST(PolyhedronTest, intersection_polygon_polyhedron_any_orientation) {
     }, cube);
 }
 
+TEST(PolyhedronTest, allocatorMemory) {
+    const size_t usedBefore = Polyhedron3d::HalfEdge::usedMemory();
+    {
+        const Polyhedron3d cube(BBox3d(16.0));
+        ASSERT_EQ(usedBefore + 24 * sizeof(Polyhedron3d::HalfEdge), Polyhedron3d::HalfEdge::usedMemory());
+        ASSERT_GE(Polyhedron3d::HalfEdge::reservedMemory(), Polyhedron3d::HalfEdge::usedMemory());
+    }
+    ASSERT_EQ(usedBefore, Polyhedron3d::HalfEdge::usedMemory());
+}
+
 bool hasVertex(const Polyhedron3d& p, const Vec3d& point) {
     return p.hasVertex(point);
 }
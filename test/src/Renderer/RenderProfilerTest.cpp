@@ -0,0 +1,241 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "GL/GLMock.h"
+#include "Renderer/RenderProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        // the profiler only uses the addresses of the views
+        static const int view3D = 0;
+        static const int viewXY = 0;
+        static const int viewXZ = 0;
+
+        static void renderProfiledFrame(RenderProfiler& profiler, const int& view, const String& name) {
+            profiler.beginFrame(&view, name);
+            profiler.beginSection("Map");
+            RenderProfiler::countUpload(64);
+            profiler.beginSection("Opaque");
+            RenderProfiler::countDrawCall();
+            RenderProfiler::countDrawCall();
+            profiler.endSection();
+            profiler.endSection();
+            profiler.beginSection("Batch");
+            RenderProfiler::countDrawCall();
+            profiler.endSection();
+            profiler.endFrame();
+        }
+
+        TEST(RenderProfilerTest, disabledProfilerRecordsNothing) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            ASSERT_FALSE(profiler.enabled());
+
+            renderProfiledFrame(profiler, view3D, "3D");
+            renderProfiledFrame(profiler, view3D, "3D");
+            ASSERT_TRUE(profiler.frames().empty());
+        }
+
+        TEST(RenderProfilerTest, recordSections) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+
+            // frames are recorded once the next frame of the same view has ended
+            renderProfiledFrame(profiler, view3D, "3D");
+            ASSERT_TRUE(profiler.frames().empty());
+            renderProfiledFrame(profiler, viewXY, "XY");
+            ASSERT_TRUE(profiler.frames().empty());
+            renderProfiledFrame(profiler, view3D, "3D");
+            ASSERT_EQ(1u, profiler.frames().size());
+            ASSERT_TRUE(profiler.lastFrame("XY") == NULL);
+
+            const RenderProfiler::Frame* frame = profiler.lastFrame("3D");
+            ASSERT_TRUE(frame != NULL);
+            ASSERT_EQ(0u, frame->number);
+            ASSERT_EQ(4u, frame->sections.size());
+
+            const RenderProfiler::Section& root = frame->sections[0];
+            ASSERT_EQ(String("Frame"), root.name);
+            ASSERT_EQ(0u, root.depth);
+            ASSERT_EQ(3u, root.drawCalls);
+            ASSERT_EQ(64u, root.uploadBytes);
+
+            const RenderProfiler::Section& map = frame->sections[1];
+            ASSERT_EQ(String("Map"), map.name);
+            ASSERT_EQ(1u, map.depth);
+            ASSERT_EQ(2u, map.drawCalls);
+            ASSERT_EQ(64u, map.uploadBytes);
+
+            const RenderProfiler::Section& opaque = frame->sections[2];
+            ASSERT_EQ(String("Opaque"), opaque.name);
+            ASSERT_EQ(2u, opaque.depth);
+            ASSERT_EQ(2u, opaque.drawCalls);
+            ASSERT_EQ(0u, opaque.uploadBytes);
+
+            const RenderProfiler::Section& batch = frame->sections[3];
+            ASSERT_EQ(1u, batch.depth);
+            ASSERT_EQ(1u, batch.drawCalls);
+
+            ASSERT_GE(root.cpuTime, map.cpuTime);
+            ASSERT_GE(map.cpuTime, opaque.cpuTime);
+
+            // the mock does not report any extensions, so there are no GPU timings
+            ASSERT_TRUE(std::isnan(root.gpuTime));
+        }
+
+        TEST(RenderProfilerTest, endFrameClosesOpenSections) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+
+            profiler.beginFrame(&view3D, "3D");
+            profiler.beginSection("Map");
+            RenderProfiler::countDrawCall();
+            profiler.endFrame();
+            renderProfiledFrame(profiler, view3D, "3D");
+
+            const RenderProfiler::Frame* frame = profiler.lastFrame("3D");
+            ASSERT_TRUE(frame != NULL);
+            ASSERT_EQ(2u, frame->sections.size());
+            ASSERT_EQ(1u, frame->sections[1].drawCalls);
+        }
+
+        TEST(RenderProfilerTest, disablingDiscardsPendingFrames) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+            renderProfiledFrame(profiler, view3D, "3D");
+
+            profiler.setEnabled(false);
+            profiler.setEnabled(true);
+            renderProfiledFrame(profiler, view3D, "3D");
+            ASSERT_TRUE(profiler.frames().empty());
+        }
+
+        TEST(RenderProfilerTest, releaseViewDeletesQueries) {
+            using namespace ::testing;
+
+            GLMock glMock;
+            glMock.setExtensions("GL_ARB_timer_query");
+
+            GLuint nextQuery = 1;
+            EXPECT_CALL(glMock, GenQueries(1, _)).WillRepeatedly(Invoke([&](GLsizei, GLuint* query) { *query = nextQuery++; }));
+            EXPECT_CALL(glMock, QueryCounter(_, GL_TIMESTAMP)).Times(AnyNumber());
+
+            std::vector<GLuint> resolvedQueries;
+            EXPECT_CALL(glMock, GetQueryObjectui64v(_, GL_QUERY_RESULT, _)).WillRepeatedly(DoAll(
+                Invoke([&](GLuint query, GLenum, GLuint64*) { resolvedQueries.push_back(query); }),
+                SetArgPointee<2>(0)));
+
+            std::vector<GLuint> deletedQueries;
+            EXPECT_CALL(glMock, DeleteQueries(_, _)).WillOnce(Invoke([&](GLsizei count, const GLuint* queries) {
+                deletedQueries.assign(queries, queries + count);
+            }));
+
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+
+            // a frame has four sections with two timestamps each
+            const int oldView = 0;
+            renderProfiledFrame(profiler, oldView, "3D");
+            ASSERT_EQ(9u, nextQuery);
+
+            // the pending frame is dropped together with the queries of the old view
+            profiler.releaseView(&oldView, true);
+            ASSERT_EQ(8u, deletedQueries.size());
+            for (GLuint query = 1; query <= 8; ++query)
+                ASSERT_TRUE(std::find(std::begin(deletedQueries), std::end(deletedQueries), query) != std::end(deletedQueries));
+
+            // a new view with the same name generates its own queries and only resolves those
+            const int newView = 0;
+            renderProfiledFrame(profiler, newView, "3D");
+            ASSERT_EQ(17u, nextQuery);
+            renderProfiledFrame(profiler, newView, "3D");
+            ASSERT_EQ(25u, nextQuery);
+
+            ASSERT_EQ(8u, resolvedQueries.size());
+            for (const GLuint query : resolvedQueries) {
+                ASSERT_GE(query, 9u);
+                ASSERT_LE(query, 16u);
+            }
+
+            ASSERT_EQ(1u, profiler.frames().size());
+            ASSERT_EQ(1u, profiler.frames().front().number);
+            ASSERT_EQ(0.0, profiler.frames().front().sections[0].gpuTime);
+
+            // releasing a view whose context is not current forgets its queries without deleting them
+            profiler.releaseView(&newView, false);
+            profiler.releaseView(&oldView, true);
+        }
+
+        TEST(RenderProfilerTest, limitFrameCount) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+
+            for (size_t i = 0; i < RenderProfiler::MaxFrameCount + 10; ++i)
+                renderProfiledFrame(profiler, view3D, "3D");
+
+            ASSERT_EQ(RenderProfiler::MaxFrameCount, profiler.frames().size());
+            ASSERT_EQ(9u, profiler.frames().front().number);
+
+            profiler.clear();
+            ASSERT_TRUE(profiler.frames().empty());
+        }
+
+        TEST(RenderProfilerTest, writeCsv) {
+            GLMock glMock;
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+            renderProfiledFrame(profiler, viewXZ, "XZ");
+            renderProfiledFrame(profiler, viewXZ, "XZ");
+
+            std::stringstream str;
+            profiler.writeCsv(str);
+
+            String line;
+            std::getline(str, line);
+            ASSERT_EQ(String("frame,view,section,depth,cpu_ms,gpu_ms,draw_calls,upload_bytes"), line);
+
+            const String expectedPrefixes[] = {
+                "0,XZ,Frame,0,",
+                "0,XZ,Frame/Map,1,",
+                "0,XZ,Frame/Map/Opaque,2,",
+                "0,XZ,Frame/Batch,1,"
+            };
+            const String expectedSuffixes[] = { ",,3,64", ",,2,64", ",,2,0", ",,1,0" };
+
+            for (size_t i = 0; i < 4; ++i) {
+                ASSERT_TRUE(std::getline(str, line));
+                ASSERT_EQ(0u, line.find(expectedPrefixes[i]));
+                ASSERT_EQ(line.size() - expectedSuffixes[i].size(), line.rfind(expectedSuffixes[i]));
+            }
+            ASSERT_FALSE(std::getline(str, line));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StringPool.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    TEST(StringPoolTest, intern) {
+        StringPool pool;
+        const String& classname = pool.intern("classname");
+        ASSERT_EQ("classname", classname);
+        ASSERT_EQ(&classname, &pool.intern(String("class") + "name"));
+        ASSERT_NE(&classname, &pool.intern("origin"));
+        ASSERT_EQ(2u, pool.size());
+    }
+    
+    TEST(StringPoolTest, internConcurrently) {
+        StringPool pool;
+        std::vector<const String*> results(8);
+        
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < results.size(); ++i) {
+            threads.push_back(std::thread([&pool, &results, i]() {
+                for (size_t j = 0; j < 1000; ++j)
+                    pool.intern(std::to_string(j));
+                results[i] = &pool.intern("target");
+            }));
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        
+        ASSERT_EQ(1001u, pool.size());
+        for (const String* result : results)
+            ASSERT_EQ(results.front(), result);
+    }
+}
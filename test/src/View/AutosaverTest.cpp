@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "MapDocumentTest.h"
+
+#include "Logger.h"
+#include "NotificationQueue.h"
+#include "IO/Path.h"
+#include "View/Autosaver.h"
+#include "View/MapDocument.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <wx/filefn.h>
+
+namespace TrenchBroom {
+    namespace View {
+        class RecordingLogger : public Logger {
+        public:
+            StringList messages;
+        private:
+            void doLog(const LogLevel level, const String& message) {
+                messages.push_back(message);
+            }
+
+            void doLog(const LogLevel level, const wxString& message) {
+                messages.push_back(message.ToStdString());
+            }
+        };
+
+        /**
+         Stands in for writing the backup files. Every write blocks until it is released and then takes a little while
+         longer, so that the tests can observe pending backups.
+         */
+        class BlockingWriter {
+        private:
+            std::promise<void> m_release;
+            std::shared_future<void> m_released;
+        public:
+            std::atomic<size_t> started;
+            std::atomic<size_t> finished;
+        public:
+            BlockingWriter() :
+            m_released(m_release.get_future().share()),
+            started(0),
+            finished(0) {}
+
+            void release() {
+                m_release.set_value();
+            }
+
+            Autosaver::WriteFile writeFile() {
+                return [this](const IO::Path& path, const String& contents) {
+                    ++started;
+                    m_released.wait();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    ++finished;
+                };
+            }
+        };
+
+        class AutosaverTest : public MapDocumentTest {
+        protected:
+            IO::Path mapDir;
+            IO::Path mapPath;
+            RecordingLogger logger;
+            NotificationQueue notificationQueue;
+            BlockingWriter writer;
+        protected:
+            void SetUp() {
+                MapDocumentTest::SetUp();
+
+                mapDir = IO::Path(::wxGetCwd().ToStdString()) + IO::Path("autosavertest");
+                mapPath = mapDir + IO::Path("test.map");
+                ::wxMkdir(mapDir.asString());
+                std::ofstream(mapPath.asString().c_str()) << "// test map" << std::endl;
+
+                document->setParentLogger(&logger);
+                document->saveDocumentAs(mapPath);
+            }
+
+            void TearDown() {
+                if (document.get() != NULL)
+                    document->setParentLogger(NULL);
+
+                ::wxRmdir((mapDir + IO::Path("autosave")).asString());
+                ::wxRemoveFile(mapPath.asString());
+                ::wxRmdir(mapDir.asString());
+            }
+
+            Autosaver* createAutosaver() {
+                return new Autosaver(document, notificationQueue, 0, 0, 50, writer.writeFile());
+            }
+
+            size_t autosaveMessageCount() const {
+                size_t count = 0;
+                for (const String& message : logger.messages) {
+                    if (StringUtils::containsCaseSensitive(message, "autosave backup"))
+                        ++count;
+                }
+                return count;
+            }
+        };
+
+        TEST_F(AutosaverTest, skipBackupWhilePending) {
+            {
+                std::unique_ptr<Autosaver> autosaver(createAutosaver());
+
+                document->addNode(createBrush(), document->currentParent());
+                autosaver->triggerAutosave();
+
+                // the first backup is still being written, so this one is skipped
+                document->addNode(createBrush(), document->currentParent());
+                autosaver->triggerAutosave();
+
+                // the destructor writes a last backup of the remaining changes
+                document->addNode(createBrush(), document->currentParent());
+                writer.release();
+            }
+
+            ASSERT_EQ(2u, writer.started);
+            ASSERT_EQ(2u, writer.finished);
+        }
+
+        TEST_F(AutosaverTest, destructorWaitsForPendingBackup) {
+            {
+                std::unique_ptr<Autosaver> autosaver(createAutosaver());
+                document->addNode(createBrush(), document->currentParent());
+                autosaver->triggerAutosave();
+                writer.release();
+            }
+
+            ASSERT_EQ(1u, writer.started);
+            ASSERT_EQ(1u, writer.finished);
+        }
+
+        TEST_F(AutosaverTest, deliverMessagesThroughNotificationQueue) {
+            {
+                std::unique_ptr<Autosaver> autosaver(createAutosaver());
+                document->addNode(createBrush(), document->currentParent());
+                autosaver->triggerAutosave();
+                writer.release();
+            }
+
+            // nothing is logged until the queue is drained
+            ASSERT_EQ(0u, autosaveMessageCount());
+            ASSERT_EQ(1u, notificationQueue.drain());
+            ASSERT_EQ(1u, autosaveMessageCount());
+        }
+
+        TEST_F(AutosaverTest, dropMessagesOfClosedDocument) {
+            {
+                std::unique_ptr<Autosaver> autosaver(createAutosaver());
+                document->addNode(createBrush(), document->currentParent());
+                autosaver->triggerAutosave();
+                writer.release();
+            }
+
+            document.reset();
+            ASSERT_EQ(1u, notificationQueue.drain());
+            ASSERT_EQ(0u, autosaveMessageCount());
+        }
+    }
+}
@@ -20,16 +20,20 @@
 #include "MapDocumentTest.h"
 
 #include "TestUtils.h"
+#include "CollectionUtils.h"
 #include "MathUtils.h"
 #include "Model/Brush.h"
 #include "Model/Entity.h"
+#include "Model/Group.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushBuilder.h"
 #include "Model/MapFormat.h"
+#include "Model/ModelUtils.h"
 #include "Model/TestGame.h"
 #include "Model/World.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
+#include "View/NodeClipboard.h"
 
 namespace TrenchBroom {
     namespace View {
@@ -166,5 +170,247 @@ namespace TrenchBroom {
             
             document->setTexture(nullptr);
         }
+        
+        class NodeChangeObserver {
+        public:
+            size_t willChangeCount;
+            size_t didChangeCount;
+            Model::NodeList changedNodes;
+            
+            NodeChangeObserver() :
+            willChangeCount(0),
+            didChangeCount(0) {}
+            
+            void nodesWillChange(const Model::NodeList& nodes) {
+                ++willChangeCount;
+            }
+            
+            void nodesDidChange(const Model::NodeList& nodes) {
+                ++didChangeCount;
+                VectorUtils::append(changedNodes, nodes);
+            }
+        };
+        
+        TEST_F(MapDocumentTest, commandsMergeNodeChangeNotifications) {
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            
+            Model::Entity* entity = new Model::Entity();
+            document->addNode(entity, document->currentParent());
+            
+            Model::Brush* brush = builder.createCube(32.0, "texture");
+            document->addNode(brush, entity);
+            document->select(brush);
+            
+            NodeChangeObserver observer;
+            document->nodesWillChangeNotifier.addObserver(&observer, &NodeChangeObserver::nodesWillChange);
+            document->nodesDidChangeNotifier.addObserver(&observer, &NodeChangeObserver::nodesDidChange);
+            
+            // the command changes the brush and its parent, but observers are notified of that only once
+            document->translateObjects(Vec3(16.0, 0.0, 0.0));
+            ASSERT_EQ(2u, observer.willChangeCount);
+            ASSERT_EQ(1u, observer.didChangeCount);
+            ASSERT_EQ(Model::NodeList({ entity, brush }), observer.changedNodes);
+            
+            document->nodesWillChangeNotifier.removeObserver(&observer, &NodeChangeObserver::nodesWillChange);
+            document->nodesDidChangeNotifier.removeObserver(&observer, &NodeChangeObserver::nodesDidChange);
+        }
+        
+        TEST_F(MapDocumentTest, removeChangedNodesInNodeChangeBatch) {
+            Model::Group* group = new Model::Group("group");
+            Model::Brush* brush = createBrush();
+            group->addChild(brush);
+            document->addNode(group, document->currentParent());
+            
+            MapDocumentCommandFacade* facade = static_cast<MapDocumentCommandFacade*>(document.get());
+            Model::Node* layer = group->parent();
+            
+            NodeChangeObserver observer;
+            document->nodesWillChangeNotifier.addObserver(&observer, &NodeChangeObserver::nodesWillChange);
+            document->nodesDidChangeNotifier.addObserver(&observer, &NodeChangeObserver::nodesDidChange);
+            
+            {
+                // the brush changes, then its group is removed
+                const MapDocumentCommandFacade::NodeChangeBatch batch(facade);
+                facade->performSelect(Model::NodeList(1, brush));
+                facade->performTransform(translationMatrix(Vec3(16.0, 0.0, 0.0)), false);
+                facade->performDeselectAll();
+                
+                Model::ParentChildrenMap nodes;
+                nodes[layer].push_back(group);
+                facade->performRemoveNodes(nodes);
+                
+                // the removed nodes are reported while they are still in the document
+                ASSERT_EQ(1u, observer.didChangeCount);
+                ASSERT_TRUE(VectorUtils::contains(observer.changedNodes, brush));
+                ASSERT_TRUE(VectorUtils::contains(observer.changedNodes, group));
+                observer.changedNodes.clear();
+            }
+            
+            // only the ancestors, which are still in the document, are reported when the batch ends
+            ASSERT_EQ(2u, observer.didChangeCount);
+            ASSERT_TRUE(VectorUtils::contains(observer.changedNodes, layer));
+            ASSERT_FALSE(VectorUtils::contains(observer.changedNodes, brush));
+            ASSERT_FALSE(VectorUtils::contains(observer.changedNodes, group));
+            
+            document->nodesWillChangeNotifier.removeObserver(&observer, &NodeChangeObserver::nodesWillChange);
+            document->nodesDidChangeNotifier.removeObserver(&observer, &NodeChangeObserver::nodesDidChange);
+            delete group;
+        }
+        
+        TEST_F(MapDocumentTest, undoCollatedTranslations) {
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            Model::Brush* brush = builder.createCube(32.0, "texture");
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+            
+            const BBox3 bounds = brush->bounds();
+            
+            // like dragging with the move tool, only the first translation takes a snapshot
+            document->beginTransaction("Move Objects");
+            document->translateObjects(Vec3(16.0, 0.0, 0.0));
+            document->translateObjects(Vec3(16.0, 0.0, 0.0));
+            document->translateObjects(Vec3(0.0, 8.0, 0.0));
+            document->commitTransaction();
+            ASSERT_EQ(bounds.translated(Vec3(32.0, 8.0, 0.0)), brush->bounds());
+            
+            document->undoLastCommand();
+            ASSERT_EQ(bounds, brush->bounds());
+            
+            document->redoNextCommand();
+            ASSERT_EQ(bounds.translated(Vec3(32.0, 8.0, 0.0)), brush->bounds());
+        }
+        
+        TEST_F(MapDocumentTest, memoryStatistics) {
+            const MapDocument::MemoryStatistics before = document->memoryStatistics();
+            ASSERT_EQ(0u, before.brushCount);
+            
+            document->addNode(createBrush(), document->currentParent());
+            document->addNode(createBrush(), document->currentParent());
+            
+            const MapDocument::MemoryStatistics after = document->memoryStatistics();
+            ASSERT_EQ(2u, after.brushCount);
+            ASSERT_EQ(12u, after.brushFaceCount);
+            ASSERT_EQ(2 * sizeof(Model::Brush), after.brushMemory);
+            ASSERT_LT(before.brushGeometryMemory, after.brushGeometryMemory);
+            ASSERT_LE(after.brushGeometryMemory, after.brushGeometryReservedMemory);
+            ASSERT_LT(before.commandMemory, after.commandMemory);
+            ASSERT_LT(before.totalMemory(), after.totalMemory());
+        }
+        
+        TEST_F(MapDocumentTest, removedNodesCountTowardsUndoHistory) {
+            Model::NodeList brushes;
+            for (size_t i = 0; i < 10; ++i) {
+                Model::Brush* brush = createBrush();
+                document->addNode(brush, document->currentParent());
+                brushes.push_back(brush);
+            }
+            const size_t brushMemory = Model::estimateMemoryUsage(brushes);
+            
+            document->select(brushes);
+            const size_t before = document->memoryStatistics().commandMemory;
+            document->deleteObjects();
+            const size_t after = document->memoryStatistics().commandMemory;
+            ASSERT_LE(before + brushMemory, after);
+            
+            document->undoLastCommand();
+            document->redoNextCommand();
+            ASSERT_EQ(after, document->memoryStatistics().commandMemory);
+        }
+        
+        TEST_F(MapDocumentTest, commandMemoryBudgetDropsOldestCommands) {
+            std::vector<Model::Brush*> brushes;
+            std::vector<size_t> usage;
+            for (size_t i = 0; i < 4; ++i) {
+                const size_t before = document->memoryStatistics().commandMemory;
+                Model::Brush* brush = createBrush();
+                document->addNode(brush, document->currentParent());
+                brushes.push_back(brush);
+                usage.push_back(document->memoryStatistics().commandMemory - before);
+            }
+            
+            // the oldest commands are dropped until the others fit into the budget
+            document->setCommandMemoryBudget(usage[2] + usage[3]);
+            ASSERT_EQ(2u, document->lastCommandCount());
+            ASSERT_EQ(usage[2] + usage[3], document->memoryStatistics().commandMemory);
+            
+            document->undoLastCommand();
+            document->undoLastCommand();
+            ASSERT_FALSE(document->canUndoLastCommand());
+            ASSERT_EQ(document->currentParent(), brushes[0]->parent());
+            ASSERT_EQ(document->currentParent(), brushes[1]->parent());
+            ASSERT_TRUE(brushes[2]->parent() == NULL);
+            ASSERT_TRUE(brushes[3]->parent() == NULL);
+            
+            document->redoNextCommand();
+            document->redoNextCommand();
+            ASSERT_EQ(2u, document->lastCommandCount());
+            ASSERT_EQ(usage[2] + usage[3], document->memoryStatistics().commandMemory);
+            
+            // the most recent command is kept even if it exceeds the budget
+            document->setCommandMemoryBudget(1);
+            ASSERT_EQ(1u, document->lastCommandCount());
+            ASSERT_EQ(usage[3], document->memoryStatistics().commandMemory);
+            
+            // collating replaces the estimate of the last command
+            document->select(brushes[3]);
+            const BBox3 bounds = brushes[3]->bounds();
+            document->translateObjects(Vec3(16.0, 0.0, 0.0));
+            const size_t moveUsage = document->memoryStatistics().commandMemory;
+            document->translateObjects(Vec3(16.0, 0.0, 0.0));
+            ASSERT_EQ(1u, document->lastCommandCount());
+            ASSERT_EQ(moveUsage, document->memoryStatistics().commandMemory);
+            
+            document->undoLastCommand();
+            ASSERT_EQ(0u, document->lastCommandCount());
+            ASSERT_EQ(bounds, brushes[3]->bounds());
+            
+            document->redoNextCommand();
+            ASSERT_EQ(1u, document->lastCommandCount());
+            ASSERT_EQ(moveUsage, document->memoryStatistics().commandMemory);
+            
+            // storing a new command clears the redo stack and its memory
+            document->undoLastCommand();
+            document->addNode(createBrush(), document->currentParent());
+            ASSERT_FALSE(document->canRedoNextCommand());
+            ASSERT_EQ(1u, document->lastCommandCount());
+            ASSERT_EQ(usage[3], document->memoryStatistics().commandMemory);
+        }
+        
+        TEST_F(MapDocumentTest, pasteClonedNodes) {
+            Model::Entity* entity = new Model::Entity();
+            entity->addOrUpdateAttribute(Model::AttributeNames::Classname, "func_wall");
+            document->addNode(entity, document->currentParent());
+            
+            Model::Brush* worldBrush = createBrush();
+            Model::Brush* entityBrush1 = createBrush();
+            Model::Brush* entityBrush2 = createBrush();
+            document->addNode(worldBrush, document->currentParent());
+            document->addNode(entityBrush1, entity);
+            document->addNode(entityBrush2, entity);
+            
+            // the selected brushes of the entity are cloned into one clone of their entity
+            document->select(Model::NodeList { worldBrush, entityBrush1, entityBrush2 });
+            const Model::NodeList clones = document->cloneSelectedNodes();
+            ASSERT_EQ(2u, clones.size());
+            ASSERT_EQ(0u, clones[0]->childCount());
+            ASSERT_EQ(2u, clones[1]->childCount());
+            
+            ASSERT_EQ(PT_Node, document->paste(clones));
+            ASSERT_EQ(3u, document->selectedNodes().brushCount());
+            ASSERT_EQ(4u, document->currentParent()->childCount());
+            ASSERT_EQ(document->currentParent(), clones[1]->parent());
+        }
+        
+        TEST_F(MapDocumentTest, clearNodeClipboardWithDocument) {
+            document->addNode(createBrush(), document->currentParent());
+            document->selectAllNodes();
+            
+            NodeClipboard& nodeClipboard = NodeClipboard::instance();
+            const NodeClipboard::Id id = nodeClipboard.store(document.get(), document->cloneSelectedNodes());
+            ASSERT_TRUE(nodeClipboard.contains(id, document.get()));
+            
+            document->newDocument(Model::MapFormat::Standard, BBox3(8192.0), Model::GameSPtr(new Model::TestGame()));
+            ASSERT_FALSE(nodeClipboard.contains(id, document.get()));
+        }
     }
 }
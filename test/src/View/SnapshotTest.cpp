@@ -27,6 +27,7 @@
 #include "Model/Entity.h"
 #include "Model/Group.h"
 #include "Model/Layer.h"
+#include "Model/Snapshot.h"
 #include "Model/World.h"
 #include "View/MapDocumentTest.h"
 #include "View/MapDocument.h"
@@ -58,5 +59,22 @@ namespace TrenchBroom {
             for (Model::BrushFace* face : brush->faces())
                 ASSERT_EQ(texture, face->texture());
         }
+        
+        TEST_F(SnapshotTest, memoryUsage) {
+            Model::Brush* brush1 = createBrush();
+            Model::Brush* brush2 = createBrush();
+            const Model::NodeList one(1, brush1);
+            const Model::NodeList two({ brush1, brush2 });
+            
+            {
+                const Model::Snapshot snapshot1(std::begin(one), std::end(one));
+                const Model::Snapshot snapshot2(std::begin(two), std::end(two));
+                ASSERT_GT(snapshot1.memoryUsage(), sizeof(Model::Snapshot));
+                ASSERT_GT(snapshot2.memoryUsage(), snapshot1.memoryUsage());
+            }
+            
+            delete brush1;
+            delete brush2;
+        }
     }
 }